@@ -0,0 +1,79 @@
+#include "../classes/Utils.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+/**
+ * @file
+ * @brief Allocation counting benchmark of the accessors of the loaded data.
+ *
+ * Replaces the global operator new to count every heap allocation, loads the dataset once, then runs the lookups
+ * Menu does for every query (getGraph(), getMap().at(code), getCity(), getAirports(), getNrAirportsPerCountry(),
+ * getDataset() and a per-airport graph statistic) and a point-to-point dijkstra with a reused SearchContext.
+ * Since Utils hands out the shared Dataset by reference, a query must not allocate at all: the benchmark returns
+ * nonzero if any of them does.
+ * Run it from the docs directory, like the application, so that ../data is found.
+ */
+
+static atomic<size_t> allocations = 0; ///< Calls of the global operator new so far.
+
+void *operator new(size_t size) {
+    allocations.fetch_add(1, memory_order_relaxed);
+    if (void *p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void *p) noexcept {free(p);}
+void operator delete(void *p, size_t) noexcept {free(p);}
+
+/**
+ * Runs query for every airport code, after one untimed warm-up round, and prints the allocations and the mean time.
+ * @return the number of allocations of the counted rounds
+ */
+template <class Query>
+static size_t run(const char *name, const vector<string> &codes, int rounds, Query query) {
+    for (const string &code : codes) query(code);
+    size_t before = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+        for (const string &code : codes) query(code);
+    auto end = std::chrono::steady_clock::now();
+    size_t counted = allocations.load() - before;
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / double(rounds * codes.size());
+    printf(" %-32s %10zu allocations %10.1f ns/query\n", name, counted, ns);
+    return counted;
+}
+
+int main() {
+    Utils utils;
+    int n = utils.getGraph().getNumVertex();
+
+    vector<string> codes;
+    for (const auto &[code, id] : utils.getMap()) codes.push_back(code);
+    sort(codes.begin(), codes.end());
+    const auto &country = utils.getNrAirportsPerCountry().begin()->first;
+    pair<string, string> city = utils.getCity().begin()->first;
+
+    volatile long sink = 0; // keeps the lookups from being optimised away
+    size_t total = 0;
+    total += run("Menu lookups (airportStats)", codes, 1000, [&](const string &code) {
+        int source = utils.getMap().at(code);
+        sink = sink + utils.getGraph().getOutDegree(source) + utils.getGraph().getNrAirlines(source);
+    });
+    total += run("shared data accessors", codes, 1000, [&](const string &) {
+        sink = sink + (long)utils.getAirports().size() + (long)utils.getCity().at(city).size() +
+               utils.getNrAirportsPerCountry().at(country) + utils.getDataset().use_count();
+    });
+
+    SearchContext context(n);
+    mt19937 rng(42);
+    total += run("dijkstra, reused context", codes, 2, [&](const string &code) {
+        sink = sink + (long)utils.getGraph().dijkstra(context, utils.getMap().at(code), (int)(rng() % n), AirlineMask());
+    });
+
+    printf(" allocations per query: %s\n", total == 0 ? "none" : "SOME");
+    return total == 0 ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+#include "../classes/Utils.h"
+#include "../classes/Minheap.h"
+#include "../classes/IndexedHeap.h"
+#include "../classes/RadixHeap.h"
+#include "../classes/BucketQueue.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+/**
+ * @file
+ * @brief Micro-benchmark of the priority queues of the graph searches on the real flights graph.
+ *
+ * Runs the same point-to-point Dijkstra (lazy insertion, decrease-key, stop at the target) with MinHeap and with
+ * IndexedHeap of several arities, over the same random airport pairs, then Graph::dijkstra and Graph::dijkstraFib,
+ * the Graph searches with each SearchQueue::Mode, then Graph::dijkstra with a RadixHeap and, counting flights, with a
+ * BucketQueue against the nrFlights BFS, and checks that all of them agree.
+ * Run it from the docs directory, like the application, so that ../data is found.
+ */
+
+/**
+ * Dijkstra over the CSR of graph with the given heap, as Graph::dijkstra does.
+ */
+template <class Heap>
+static double search(const Graph &graph, SearchContext &context, Heap &heap, int src, int dest) {
+    const CSR &csr = graph.getCSR();
+    context.setDistance(src, 0, -1);
+    heap.insert(src, 0);
+    while (!heap.empty()) {
+        int u = heap.extractMin();
+        context.setVisited(u);
+        if (u == dest) break;
+        for (int e = csr.offsets[u]; e < csr.offsets[u + 1]; e++) {
+            int v = csr.dest[e];
+            double d = context.getDistance(u) + csr.weight[e];
+            if (context.isVisited(v) || d >= context.getDistance(v)) continue;
+            bool queued = context.getDistance(v) != SearchContext::INF;
+            context.setDistance(v, d, u);
+            if (queued) heap.decreaseKey(v, d);
+            else heap.insert(v, d);
+        }
+    }
+    return context.getDistance(dest);
+}
+
+/**
+ * Runs every query with a heap made by make (a new heap per query when fresh is set) and prints the mean time.
+ */
+template <class Make>
+static vector<double> run(const char *name, const Graph &graph, const vector<pair<int, int>> &queries, Make make) {
+    int n = graph.getNumVertex();
+    SearchContext context(n);
+    vector<double> distances;
+    auto start = std::chrono::steady_clock::now();
+    for (auto [src, dest] : queries) {
+        context.reset(n);
+        distances.push_back(make(context, src, dest));
+    }
+    auto end = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(end - start).count() / (double)queries.size();
+    printf(" %-28s %8.1f us/query\n", name, us);
+    return distances;
+}
+
+int main() {
+    Utils utils;
+    const Graph &graph = utils.getGraph();
+    int n = graph.getNumVertex();
+
+    mt19937 rng(42);
+    vector<pair<int, int>> queries;
+    for (int i = 0; i < 5000; i++) queries.emplace_back((int)(rng() % n), (int)(rng() % n));
+
+    auto minHeap = run("MinHeap (unordered_map)", graph, queries, [&](SearchContext &c, int s, int t) {
+        MinHeap<int, double> heap(n, -1);
+        return search(graph, c, heap, s, t);
+    });
+    IndexedHeap<double, 2> binary(n);
+    auto d2 = run("IndexedHeap<2>", graph, queries, [&](SearchContext &c, int s, int t) {
+        binary.reset(n);
+        return search(graph, c, binary, s, t);
+    });
+    IndexedHeap<double, 4> quaternary(n);
+    auto d4 = run("IndexedHeap<4>", graph, queries, [&](SearchContext &c, int s, int t) {
+        quaternary.reset(n);
+        return search(graph, c, quaternary, s, t);
+    });
+    IndexedHeap<double, 8> octonary(n);
+    auto d8 = run("IndexedHeap<8>", graph, queries, [&](SearchContext &c, int s, int t) {
+        octonary.reset(n);
+        return search(graph, c, octonary, s, t);
+    });
+    auto dijkstra = run("Graph::dijkstra", graph, queries, [&](SearchContext &c, int s, int t) {
+        return graph.dijkstra(c, s, t, AirlineMask());
+    });
+    auto fibonacci = run("Graph::dijkstraFib", graph, queries, [&](SearchContext &c, int s, int t) {
+        return graph.dijkstraFib(c, s, t, AirlineMask());
+    });
+
+    printf("\n");
+    bool modesAgree = true;
+    for (auto mode : {SearchQueue::DECREASE_KEY, SearchQueue::DUPLICATES}) {
+        bool duplicates = mode == SearchQueue::DUPLICATES;
+        SearchContext backward(n);
+        backward.setQueueMode(mode);
+        auto withMode = [&](auto search) {
+            return [&, search](SearchContext &c, int s, int t) {
+                c.setQueueMode(mode);
+                return search(c, s, t);
+            };
+        };
+        auto d = run(duplicates ? "dijkstra, duplicates" : "dijkstra, decrease-key", graph, queries,
+                     withMode([&](SearchContext &c, int s, int t) {return graph.dijkstra(c, s, t, AirlineMask());}));
+        auto a = run(duplicates ? "aStar, duplicates" : "aStar, decrease-key", graph, queries,
+                     withMode([&](SearchContext &c, int s, int t) {return graph.aStar(c, s, t, AirlineMask());}));
+        auto b = run(duplicates ? "bidirectional, duplicates" : "bidirectional, decrease-key", graph, queries,
+                     withMode([&](SearchContext &c, int s, int t) {
+                         return graph.bidirectionalDijkstra(c, backward, s, t, AirlineMask());
+                     }));
+        for (size_t i = 0; i < queries.size(); i++)
+            if (abs(d[i] - minHeap[i]) > 1e-6 || abs(a[i] - minHeap[i]) > 1e-6 || abs(b[i] - minHeap[i]) > 1e-6)
+                modesAgree = false;
+    }
+
+    printf("\n");
+    RadixHeap radix(n);
+    auto radixDistances = run("dijkstra, RadixHeap", graph, queries, [&](SearchContext &c, int s, int t) {
+        return graph.dijkstra(c, radix, s, t, AirlineMask());
+    });
+    auto bfs = run("nrFlights (BFS)", graph, queries, [&](SearchContext &c, int s, int t) {
+        return (double)graph.nrFlights(c, s, t, AirlineMask());
+    });
+    IndexedHeap<double> hopsHeap(n);
+    auto hopsHeapFlights = run("hops, IndexedHeap<4>", graph, queries, [&](SearchContext &c, int s, int t) {
+        double flights = graph.dijkstra(c, hopsHeap, s, t, AirlineMask(), true);
+        return flights == SearchContext::INF ? 0 : flights;
+    });
+    BucketQueue buckets(n, 1);
+    auto bucketFlights = run("hops, BucketQueue", graph, queries, [&](SearchContext &c, int s, int t) {
+        double flights = graph.dijkstra(c, buckets, s, t, AirlineMask(), true);
+        return flights == SearchContext::INF ? 0 : flights;
+    });
+
+    bool same = minHeap == d2 && minHeap == d4 && minHeap == d8 && minHeap == dijkstra && minHeap == fibonacci && modesAgree &&
+                minHeap == radixDistances && bfs == hopsHeapFlights && bfs == bucketFlights;
+    printf(" distances %s\n", same ? "identical" : "DIFFER");
+    return same ? 0 : 1;
+}
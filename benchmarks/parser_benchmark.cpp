@@ -0,0 +1,113 @@
+#include "../classes/Utils.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <random>
+#include <unistd.h>
+
+/**
+ * @file
+ * @brief Regression benchmark of the Parser constructions per query.
+ *
+ * Loads the dataset once, as a Menu session does, then answers city to city and random airport to airport queries
+ * the way Menu::processOperation does (processFlight and printPathsByFlights for every best pair, processDistance
+ * and printPathsByDistance, ...) and checks after every query that no Parser was constructed again: answering a
+ * query must cost the searches only, never a reload of the CSV files.
+ * Run it from the docs directory, like the application, so that ../data is found.
+ */
+
+static constexpr int PATHS_SHOWN = 20; ///< Routes with the fewest flights printed per pair, as Menu does.
+
+/**
+ * Sends stdout to /dev/null while it lives, so the printed routes do not drown the results.
+ */
+class Silence {
+public:
+    Silence() {
+        fflush(stdout);
+        cout.flush();
+        saved = dup(STDOUT_FILENO);
+        int null = open("/dev/null", O_WRONLY);
+        dup2(null, STDOUT_FILENO);
+        close(null);
+    }
+    ~Silence() {
+        fflush(stdout);
+        cout.flush();
+        dup2(saved, STDOUT_FILENO);
+        close(saved);
+    }
+
+private:
+    int saved;
+};
+
+/**
+ * Answers a query with every criterion of the Menu, printing the routes as Menu::processOperation does.
+ */
+static void answer(Utils &utils, SearchContext &context, SearchContext &backward, const vector<string> &src,
+                   const vector<string> &dest, const AirlineMask &mask) {
+    const Graph &graph = utils.getGraph();
+    const auto &map = utils.getMap();
+
+    int nrFlights, nrPath = 0;
+    for (const auto &[source, target] : utils.processFlight(nrFlights, src, dest, mask))
+        graph.printPathsByFlights(context, nrPath, map.at(source), map.at(target), mask, PATHS_SHOWN);
+
+    double distance;
+    nrPath = 0;
+    for (const auto &[source, target] : utils.processDistance(distance, src, dest, mask)) {
+        graph.printPathsByDistance(context, backward, nrPath, map.at(source), map.at(target), mask);
+        graph.printAlternativePaths(context, map.at(source), map.at(target), 3, mask);
+    }
+
+    vector<int> path;
+    vector<Airline::Id> legs;
+    if (utils.processChanges(distance, path, legs, src, dest, mask) != INT_MAX) graph.printRoute(path, legs);
+
+    vector<vector<int>> paths;
+    utils.processPareto(paths, src, dest, mask);
+    utils.processHopLimited(4, src, dest, mask);
+}
+
+int main() {
+    Utils utils;
+    const Graph &graph = utils.getGraph();
+    int n = graph.getNumVertex();
+    int afterLoad = Parser::getConstructions();
+
+    // Menu passes the airports of a city, of a location or a single airport
+    const auto &cities = utils.getCity();
+    vector<pair<vector<string>, vector<string>>> queries = {
+        {cities.at({"France", "Paris"}), cities.at({"United Kingdom", "London"})},
+        {cities.at({"United States", "New York"}), cities.at({"France", "Paris"})},
+        {cities.at({"United Kingdom", "London"}), cities.at({"United States", "New York"})},
+    };
+    vector<string> codes(n);
+    for (const auto &[code, id] : utils.getMap()) codes[id] = code;
+    mt19937 rng(42);
+    for (int i = 0; i < 30; i++) queries.push_back({{codes[rng() % n]}, {codes[rng() % n]}});
+
+    SearchContext context(n), backward(n);
+    AirlineMask mask;
+    int failures = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto &[src, dest] : queries) {
+        {
+            Silence silence;
+            answer(utils, context, backward, src, dest, mask);
+        }
+        if (Parser::getConstructions() != afterLoad) failures++;
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count() / (double)queries.size();
+
+    int constructions = Parser::getConstructions();
+    printf(" %zu queries, %8.2f ms/query\n", queries.size(), ms);
+    printf(" Parser constructions: %d at load, %d while answering (%d queries constructed one)\n",
+           afterLoad, constructions - afterLoad, failures);
+    bool ok = afterLoad == 1 && constructions == 1;
+    printf(" one Parser per session: %s\n", ok ? "yes" : "NO");
+    return ok ? 0 : 1;
+}
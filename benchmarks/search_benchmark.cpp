@@ -0,0 +1,339 @@
+#include "../classes/Utils.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <random>
+
+/**
+ * @file
+ * @brief Differential benchmark of the point-to-point distance searches on the real flights graph.
+ *
+ * Runs every search over the same random airport pairs, once with every airline and once with a restrictive
+ * AirlineMask (the few airlines with the most flights, between airports they fly from). Prints the mean time and the
+ * mean number of settled airports per query, and checks every distance against a Dijkstra that settles the whole
+ * graph (Graph::shortestDistances).
+ * Then checks the set to set searches (Graph::nearestDistance and Graph::nearestFlights) on the airports around random
+ * airports, some of them on both sides, against the best value and every tied pair of the pairwise searches.
+ * Also checks that a landmarks file holding fewer landmarks than requested is read back instead of recomputed, and
+ * that Graph::fewestAirlineChanges counts a route with more changes than any real one.
+ * Returns nonzero on any mismatch.
+ * Run it from the docs directory, like the application, so that ../data is found.
+ */
+
+static constexpr int QUERIES = 2000;       ///< Random airport pairs per mask.
+static constexpr int MASK_AIRLINES = 3;    ///< Airlines of the restrictive mask.
+static constexpr int LANDMARKS = 16;       ///< Landmarks of the ALT heuristic (Parser::loadLandmarks).
+static constexpr int SETS = 200;           ///< Random (sources, targets) airport sets per mask.
+static constexpr double RADIUS = 400;      ///< Radius, in km, of the airport sets.
+static constexpr int CHAIN_AIRLINES = 300; ///< Airlines, one per flight, of the chain of checkManyChanges.
+
+/**
+ * A search under test: answers one query and counts the airports it settled.
+ */
+struct Search {
+    const char *name;
+    function<double(int src, int dest, const AirlineMask &airlines)> distance;
+    function<int()> settled; ///< Airports settled by the last call of distance.
+};
+
+/**
+ * Counts the airports marked as visited by the last search of context.
+ */
+static int settledIn(const SearchContext &context, int n) {
+    int settled = 0;
+    for (int v = 0; v < n; v++) settled += context.isVisited(v);
+    return settled;
+}
+
+/**
+ * Runs every search over queries, prints their mean time and settled airports and checks them against expected.
+ * @return the number of queries where some search differs from expected
+ */
+static int compare(const vector<Search> &searches, const vector<pair<int, int>> &queries,
+                   const vector<double> &expected, const AirlineMask &airlines) {
+    int mismatches = 0;
+    vector<bool> wrong(queries.size(), false);
+    for (const Search &search : searches) {
+        double seconds = 0, settled = 0;
+        int differ = 0;
+        for (size_t i = 0; i < queries.size(); i++) {
+            auto start = std::chrono::steady_clock::now();
+            double d = search.distance(queries[i].first, queries[i].second, airlines);
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            settled += search.settled();
+            if (abs(d - expected[i]) > 1e-6) {
+                differ++;
+                wrong[i] = true;
+            }
+        }
+        printf(" %-28s %8.1f us/query %8.1f settled/query %6d differ\n", search.name,
+               seconds * 1e6 / (double)queries.size(), settled / (double)queries.size(), differ);
+    }
+    for (bool w : wrong) mismatches += w;
+    return mismatches;
+}
+
+/**
+ * Best total and every pair tied with it, from pairwise results: value(i, j) is the total from sources[i] to
+ * targets[j] and self(j) the one of targets[j] from itself (unreachable when it is not a source). As in the set to
+ * set searches, a target is only reported from the sources other than itself that are the closest to it.
+ */
+template <class T, class Value, class Self>
+static pair<T, vector<pair<int, int>>> pairwiseBest(const vector<int> &sources, const vector<int> &targets,
+                                                    T unreachable, Value value, Self self) {
+    T best = unreachable;
+    vector<pair<int, int>> pairs;
+    vector<int> closestSources;
+    for (size_t j = 0; j < targets.size(); j++) {
+        T closest = self(j);
+        for (size_t i = 0; i < sources.size(); i++)
+            if (sources[i] != targets[j]) closest = min(closest, value(i, j));
+        closestSources.clear();
+        for (size_t i = 0; i < sources.size(); i++)
+            if (sources[i] != targets[j] && value(i, j) == closest) closestSources.push_back(sources[i]);
+        if (closest == unreachable || closestSources.empty() || closest > best) continue;
+        if (closest < best) {
+            best = closest;
+            pairs.clear();
+        }
+        for (int s : closestSources) pairs.emplace_back(s, targets[j]);
+    }
+    sort(pairs.begin(), pairs.end());
+    return {best, pairs};
+}
+
+/**
+ * Draws the sources and the targets of a set to set query: the airports within radius of two random airports.
+ * With shared, one source is also made a target.
+ */
+static pair<vector<int>, vector<int>> randomSets(const Utils &utils, double radius, bool shared, mt19937 &rng) {
+    const Graph &graph = utils.getGraph();
+    int n = graph.getNumVertex();
+    Airport from = graph.getVertexSet()[rng() % n]->getAirport(), to = graph.getVertexSet()[rng() % n]->getAirport();
+    vector<int> sources = utils.airportIds(utils.localAirports(from.getLatitude(), from.getLongitude(), radius));
+    vector<int> targets = utils.airportIds(utils.localAirports(to.getLatitude(), to.getLongitude(), radius));
+    if (shared) {
+        targets.push_back(sources[rng() % sources.size()]);
+        sort(targets.begin(), targets.end());
+        targets.erase(unique(targets.begin(), targets.end()), targets.end());
+    }
+    return {sources, targets};
+}
+
+/**
+ * Checks nearestDistance and nearestFlights (zero offsets, as Utils calls them) on SETS random airport sets against
+ * the pairwise searches (shortestDistances and flightsMatrix), then nearestDistance with offsets on SETS smaller sets
+ * where a source also starts from the first airport one of its flights reaches, at the length of that flight, so
+ * that both are the closest sources of every target reached through it; the pairwise reference is then
+ * nearestDistance from each source alone.
+ * @return the number of sets where a search differs
+ */
+static int compareSets(const Utils &utils, SearchContext &context, const AirlineMask &airlines, mt19937 &rng) {
+    const Graph &graph = utils.getGraph();
+    int mismatches = 0, shared = 0, tiedFlights = 0, tiedDistance = 0;
+    double seconds = 0, pairwiseSeconds = 0;
+    vector<pair<int, int>> distancePairs, flightPairs;
+    for (int set = 0; set < SETS; set++) {
+        auto [sources, targets] = randomSets(utils, RADIUS, set % 4 == 0, rng);
+        auto isSource = [&](size_t j) {return find(sources.begin(), sources.end(), targets[j]) != sources.end();};
+
+        vector<pair<int, double>> sourceOffsets, targetOffsets;
+        for (int v : sources) sourceOffsets.emplace_back(v, 0);
+        for (int v : targets) targetOffsets.emplace_back(v, 0);
+        auto start = std::chrono::steady_clock::now();
+        double distance = graph.nearestDistance(context, sourceOffsets, targetOffsets, airlines, distancePairs);
+        int flights = graph.nearestFlights(context, sources, targets, airlines, flightPairs);
+        auto middle = std::chrono::steady_clock::now();
+        vector<vector<double>> distances;
+        for (int v : sources) {
+            graph.shortestDistances(context, v, airlines);
+            distances.emplace_back();
+            for (int t : targets) distances.back().push_back(context.getDistance(t));
+        }
+        vector<vector<int>> flightCounts = graph.flightsMatrix(context, sources, targets, airlines);
+        seconds += std::chrono::duration<double>(middle - start).count();
+        pairwiseSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - middle).count();
+
+        auto expectedDistance = pairwiseBest(sources, targets, SearchContext::INF,
+                                             [&](size_t i, size_t j) {return distances[i][j];},
+                                             [&](size_t j) {return isSource(j) ? 0 : SearchContext::INF;});
+        auto expectedFlights = pairwiseBest(sources, targets, INT_MAX,
+                                            [&](size_t i, size_t j) {
+                                                return flightCounts[i][j] == 0 ? INT_MAX : flightCounts[i][j];
+                                            },
+                                            [&](size_t j) {return isSource(j) ? 0 : INT_MAX;});
+        sort(distancePairs.begin(), distancePairs.end());
+        sort(flightPairs.begin(), flightPairs.end());
+        for (size_t j = 0; j < targets.size(); j++) shared += isSource(j);
+        tiedDistance += distancePairs.size() > 1;
+        tiedFlights += flightPairs.size() > 1;
+        if (distance != expectedDistance.first || distancePairs != expectedDistance.second ||
+            flights != expectedFlights.first || flightPairs != expectedFlights.second)
+            mismatches++;
+    }
+
+    int offsetMismatches = 0, tiedOffsets = 0;
+    vector<pair<int, int>> ignored;
+    for (int set = 0; set < SETS; set++) {
+        auto [sources, targets] = randomSets(utils, RADIUS / 4, set % 2 == 0, rng);
+        vector<pair<int, double>> sourceOffsets, targetOffsets;
+        for (int v : sources) sourceOffsets.emplace_back(v, 0);
+        for (int v : targets) targetOffsets.emplace_back(v, 0);
+        for (int e = graph.edgesBegin(sources[0]); e < graph.edgesEnd(sources[0]); e++) {
+            int next = graph.getEdgeDest(e);
+            bool isSource = find(sources.begin(), sources.end(), next) != sources.end();
+            if (!airlines.allows(graph.getEdgeAirline(e)) || isSource) continue;
+            sources.push_back(next);
+            sourceOffsets.emplace_back(next, graph.getEdgeWeight(e));
+            break;
+        }
+
+        double distance = graph.nearestDistance(context, sourceOffsets, targetOffsets, airlines, distancePairs);
+        vector<vector<double>> totals(sources.size(), vector<double>(targets.size(), SearchContext::INF));
+        for (size_t i = 0; i < sources.size(); i++)
+            for (size_t j = 0; j < targets.size(); j++)
+                if (sources[i] != targets[j])
+                    totals[i][j] = graph.nearestDistance(context, {sourceOffsets[i]}, {targetOffsets[j]}, airlines,
+                                                         ignored);
+        auto expected = pairwiseBest(sources, targets, SearchContext::INF,
+                                     [&](size_t i, size_t j) {return totals[i][j];},
+                                     [&](size_t j) {
+                                         for (auto [v, offset] : sourceOffsets)
+                                             if (v == targets[j]) return offset;
+                                         return SearchContext::INF;
+                                     });
+        sort(distancePairs.begin(), distancePairs.end());
+        tiedOffsets += distancePairs.size() > 1;
+        if (distance != expected.first || distancePairs != expected.second) offsetMismatches++;
+    }
+
+    printf(" %-28s %8.1f us/set %8.1f us/set pairwise %6d differ\n", "nearestDistance+Flights",
+           seconds * 1e6 / SETS, pairwiseSeconds * 1e6 / SETS, mismatches);
+    printf("   %d targets also sources, tied pairs in %d (distance) and %d (flights) of %d sets\n",
+           shared, tiedDistance, tiedFlights, SETS);
+    printf(" %-28s %6d differ, tied pairs in %d of %d sets\n", "nearestDistance, offsets", offsetMismatches,
+           tiedOffsets, SETS);
+    return mismatches + offsetMismatches;
+}
+
+/**
+ * Saves the landmarks of a chain of three airports, where farthest selection runs out of airports before LANDMARKS,
+ * and checks that load accepts the file for that same k, and only for it.
+ * @return 0 if the file is reused, 1 otherwise
+ */
+static int checkShortLandmarks() {
+    Graph chain(3);
+    chain.addFlight(0, 1, 0, 100);
+    chain.addFlight(1, 2, 0, 100);
+    chain.freeze();
+
+    Landmarks computed(chain, LANDMARKS), loaded, other;
+    string path = (filesystem::temp_directory_path() / "search_benchmark_landmarks.snapshot").string();
+    bool reused = computed.save(path, 0) && loaded.load(path, 0, chain.getNumVertex(), LANDMARKS) &&
+                  loaded.getLandmarks() == computed.getLandmarks() &&
+                  !other.load(path, 0, chain.getNumVertex(), LANDMARKS - 1);
+    remove(path.c_str());
+
+    size_t selected = computed.getLandmarks().size();
+    printf("\n landmarks file with %zu of %d landmarks: %s\n", selected, LANDMARKS, reused ? "reused" : "RECOMPUTED");
+    return reused && selected < (size_t)LANDMARKS ? 0 : 1;
+}
+
+/**
+ * Runs Graph::fewestAirlineChanges along a chain of airports where every flight is of another airline, so the only
+ * route has CHAIN_AIRLINES - 1 changes.
+ * @return 0 if the route and its changes are found, 1 otherwise
+ */
+static int checkManyChanges() {
+    Graph chain(CHAIN_AIRLINES + 1);
+    for (int a = 0; a < CHAIN_AIRLINES; a++)
+        chain.addFlight(a, a + 1, (Airline::Id)a, 100);
+    chain.freeze();
+
+    SearchContext context(chain.getNumVertex());
+    double distance;
+    vector<int> path;
+    vector<Airline::Id> legs;
+    int changes = chain.fewestAirlineChanges(context, {0}, {CHAIN_AIRLINES}, AirlineMask(), distance, path, legs);
+    bool found = changes == CHAIN_AIRLINES - 1 && (int)legs.size() == CHAIN_AIRLINES &&
+                 abs(distance - 100.0 * CHAIN_AIRLINES) < 1e-6;
+    printf(" route with %d airline changes: %s\n", CHAIN_AIRLINES - 1, found ? "found" : "NOT FOUND");
+    return found ? 0 : 1;
+}
+
+int main() {
+    Utils utils;
+    const Graph &graph = utils.getGraph();
+    int n = graph.getNumVertex();
+
+    vector<Airline::Id> ids(Airline::nrIds());
+    for (size_t i = 0; i < ids.size(); i++) ids[i] = (Airline::Id)i;
+    partial_sort(ids.begin(), ids.begin() + MASK_AIRLINES, ids.end(), [&graph](Airline::Id a, Airline::Id b) {
+        return graph.airlineFlights(a) > graph.airlineFlights(b);
+    });
+    Airline::IdH selected(ids.begin(), ids.begin() + MASK_AIRLINES);
+
+    Landmarks landmarks = utils.loadLandmarks(LANDMARKS);
+    utils.loadHierarchy();
+
+    SearchContext context(n), backward(n);
+    vector<Search> searches = {
+        {"dijkstra, whole graph",
+         [&](int s, int t, const AirlineMask &m) {
+             graph.shortestDistances(context, s, m);
+             return context.getDistance(t);
+         },
+         [&] {return settledIn(context, n);}},
+        {"dijkstra, stops at dest",
+         [&](int s, int t, const AirlineMask &m) {return graph.dijkstra(context, s, t, m);},
+         [&] {return settledIn(context, n);}},
+        {"bidirectionalDijkstra",
+         [&](int s, int t, const AirlineMask &m) {return graph.bidirectionalDijkstra(context, backward, s, t, m);},
+         [&] {return settledIn(context, n) + settledIn(backward, n);}},
+        {"distance (hierarchy)",
+         [&](int s, int t, const AirlineMask &m) {return graph.distance(context, backward, s, t, m);},
+         [&] {return settledIn(context, n) + settledIn(backward, n);}},
+        {"aStar",
+         [&](int s, int t, const AirlineMask &m) {return graph.aStar(context, s, t, m);},
+         [&] {return settledIn(context, n);}},
+        {"aStar, ALT landmarks",
+         [&](int s, int t, const AirlineMask &m) {return graph.aStar(context, s, t, m, &landmarks);},
+         [&] {return settledIn(context, n);}},
+    };
+
+    int mismatches = 0;
+    mt19937 rng(42);
+    for (bool restrictive : {false, true}) {
+        AirlineMask airlines = restrictive ? AirlineMask(selected) : AirlineMask();
+        vector<int> airports; // airports with a flight of the mask
+        for (int v = 0; v < n; v++)
+            for (int e = graph.edgesBegin(v); e < graph.edgesEnd(v); e++)
+                if (airlines.allows(graph.getEdgeAirline(e))) {
+                    airports.push_back(v);
+                    break;
+                }
+        vector<pair<int, int>> queries;
+        for (int i = 0; i < QUERIES; i++)
+            queries.emplace_back(airports[rng() % airports.size()], airports[rng() % airports.size()]);
+
+        vector<double> expected;
+        int reachable = 0;
+        for (auto [src, dest] : queries) {
+            graph.shortestDistances(context, src, airlines);
+            expected.push_back(context.getDistance(dest));
+            reachable += expected.back() != SearchContext::INF;
+        }
+        printf("\n %s: %zu pairs, %d reachable\n", restrictive ? "restrictive mask" : "every airline",
+               queries.size(), reachable);
+        mismatches += compare(searches, queries, expected, airlines);
+        mismatches += compareSets(utils, context, airlines, rng);
+    }
+
+    mismatches += checkShortLandmarks();
+    mismatches += checkManyChanges();
+
+    printf("\n distances %s\n", mismatches == 0 ? "identical" : "DIFFER");
+    return mismatches == 0 ? 0 : 1;
+}
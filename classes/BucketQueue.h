@@ -0,0 +1,154 @@
+#ifndef AIRBUSMANAGEMENTSYSTEM_BUCKETQUEUE_H
+#define AIRBUSMANAGEMENTSYSTEM_BUCKETQUEUE_H
+
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains the BucketQueue class, Dial's priority queue for searches with small integer weights.
+ */
+
+/**
+ * @class BucketQueue
+ * @brief Dial's bucket queue of vertices with integer keys, for searches whose edge weights are integers in
+ * [0, C] (C = 1 when every flight counts as one hop).
+ *
+ * Every queued key lies in [d, d + C], d being the last extracted key, so C + 1 buckets used as a ring are enough:
+ * a key goes to bucket key % (C + 1) and the minimum is found by walking the ring from d.\n
+ * A decreaseKey pushes a new entry and the stale one is skipped when it comes out, as in
+ * SearchQueue::DUPLICATES. The interface is the one of IndexedHeap, so Graph::dijkstra can be instantiated with it.
+ */
+class BucketQueue {
+public:
+    static constexpr int KEY_NOT_FOUND = -1; ///< Returned by extractMin when the queue is empty.
+
+    /**
+     * @brief Constructor for an empty queue of the vertices 0..n-1.
+     * @param n Number of vertices.
+     * @param maxWeight Largest edge weight C.
+     */
+    explicit BucketQueue(int n = 0, int maxWeight = 1) : ring(maxWeight + 1) {reset(n);}
+
+    /**
+     * @brief Empties the queue and makes room for the vertices 0..n-1.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(C + N)</b>, N -> number of entries still queued (O(n) only when it grows)
+     * </pre>
+     */
+    void reset(int n);
+
+    [[nodiscard]] bool empty() const {return live == 0;}
+    [[nodiscard]] bool contains(int key) const {return queued[key];}
+
+    /**
+     * @brief Queues a vertex that is not queued; value must be an integer in [last extracted, last extracted + C].\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(1)</b>
+     * </pre>
+     */
+    void insert(int key, double value);
+
+    /**
+     * @brief Lowers the value of a queued vertex (a larger value is ignored).\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(1)</b>
+     * </pre>
+     */
+    void decreaseKey(int key, double value);
+
+    /**
+     * @brief Removes and returns the vertex with the smallest value.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(C)</b> worst case, O(1) amortized over a search
+     * </pre>
+     * @return The vertex, or KEY_NOT_FOUND if the queue is empty.
+     */
+    int extractMin();
+
+    /**
+     * @brief Returns the smallest value without removing it.
+     * @note The queue must not be empty.
+     */
+    double minValue();
+
+private:
+    struct Entry {
+        long long value;
+        int key;
+    };
+
+    std::vector<std::vector<Entry>> ring; // bucket value % ring.size() holds the entries of that value
+    long long current = 0;                // smallest value that may still be queued
+    int live = 0;                         // number of queued vertices
+    std::vector<long long> latest;        // value of the live entry of each vertex
+    std::vector<bool> queued;             // the vertex has a live entry
+
+    [[nodiscard]] std::vector<Entry> &bucketOf(long long value) {return ring[value % (long long)ring.size()];}
+
+    [[nodiscard]] bool isStale(const Entry &e) const {return !queued[e.key] || latest[e.key] != e.value;}
+
+    /**
+     * Moves current to the bucket holding the minimum and makes its back a live entry.
+     */
+    void settle();
+};
+
+inline void BucketQueue::reset(int n) {
+    for (auto &bucket : ring) {
+        for (const Entry &e : bucket) queued[e.key] = false;
+        bucket.clear();
+    }
+    current = 0;
+    live = 0;
+    if ((int)queued.size() < n) {
+        latest.resize(n);
+        queued.resize(n, false);
+    }
+}
+
+inline void BucketQueue::insert(int key, double value) {
+    if (queued[key]) return; // The key already exists, do nothing
+    auto v = (long long)value;
+    queued[key] = true;
+    latest[key] = v;
+    live++;
+    bucketOf(v).push_back({v, key});
+}
+
+inline void BucketQueue::decreaseKey(int key, double value) {
+    auto v = (long long)value;
+    if (!queued[key] || latest[key] < v) return;
+    latest[key] = v; // the older entry is stale from now on
+    bucketOf(v).push_back({v, key});
+}
+
+inline void BucketQueue::settle() {
+    while (true) {
+        std::vector<Entry> &bucket = bucketOf(current);
+        while (!bucket.empty() && isStale(bucket.back())) bucket.pop_back();
+        if (!bucket.empty()) return;
+        current++;
+    }
+}
+
+inline int BucketQueue::extractMin() {
+    if (live == 0) return KEY_NOT_FOUND;
+    settle();
+    std::vector<Entry> &bucket = bucketOf(current);
+    int key = bucket.back().key;
+    bucket.pop_back();
+    queued[key] = false;
+    live--;
+    return key;
+}
+
+inline double BucketQueue::minValue() {
+    settle();
+    return (double)bucketOf(current).back().value;
+}
+
+#endif //AIRBUSMANAGEMENTSYSTEM_BUCKETQUEUE_H
@@ -0,0 +1,96 @@
+#ifndef AIRBUSMANAGEMENTSYSTEM_CSVREADER_H
+#define AIRBUSMANAGEMENTSYSTEM_CSVREADER_H
+
+#include <string_view>
+#include <charconv>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @file
+ * @brief Contains the CsvReader class that tokenizes a CSV buffer without copying it.
+ */
+
+/**
+ * @class CsvReader
+ * @brief Splits a CSV buffer (usually a MappedFile) into lines and fields.
+ *
+ * Lines and fields are string_view slices of the buffer, so reading a row allocates nothing;
+ * a field only becomes a string when the caller keeps it.\n
+ * Like the files of the dataset, fields are separated by ',' and are never quoted.
+ */
+class CsvReader {
+public:
+    /**
+     * @brief Constructor for a reader over the whole buffer.
+     * @param text The CSV contents, it must outlive the reader and the views it returns.
+     */
+    explicit CsvReader(string_view text) : text(text) {}
+
+    /**
+     * @brief Skips the header line.
+     */
+    void skipLine() {
+        string_view line;
+        nextLine(line);
+    }
+
+    /**
+     * @brief Reads the next non-empty line, without the line terminator.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(n)</b>, n -> size of the line
+     * </pre>
+     * @param line Set to the line read.
+     * @return false when there are no more lines.
+     */
+    bool nextLine(string_view &line) {
+        while (pos < text.size()) {
+            size_t end = text.find('\n', pos);
+            if (end == string_view::npos) end = text.size();
+            line = text.substr(pos, end - pos);
+            pos = end + 1;
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (!line.empty()) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Removes the first field from the line.
+     * @param line The rest of the line, advanced past the field and its ','.
+     * @return The field.
+     */
+    static string_view nextField(string_view &line) {
+        size_t end = min(line.find(','), line.size());
+        string_view field = line.substr(0, end);
+        line.remove_prefix(min(end + 1, line.size()));
+        return field;
+    }
+
+    /**
+     * @brief Parses a decimal number with from_chars (no locale, no allocation).
+     * @param field The field to parse.
+     * @return The number, or 0 if the field is not a number.
+     */
+    static double toDouble(string_view field) {
+        double value = 0;
+        from_chars(field.data(), field.data() + field.size(), value);
+        return value;
+    }
+
+    /**
+     * @brief Counts the lines left, to reserve space before reading them.
+     */
+    [[nodiscard]] size_t countLines() const {
+        if (pos >= text.size()) return 0;
+        return count(text.begin() + (long)pos, text.end(), '\n') + 1;
+    }
+
+private:
+    string_view text; ///< The whole CSV buffer.
+    size_t pos = 0;   ///< Start of the next line.
+};
+
+#endif //AIRBUSMANAGEMENTSYSTEM_CSVREADER_H
@@ -0,0 +1,42 @@
+#ifndef AIRBUSMANAGEMENTSYSTEM_DATASET_H
+#define AIRBUSMANAGEMENTSYSTEM_DATASET_H
+
+#include <unordered_map>
+#include <unordered_set>
+#include <list>
+#include <string>
+#include "airport.h"
+#include "airline.h"
+#include "../network/graph.h"
+
+using namespace std;
+
+/**
+ * @file
+ * @brief Contains the Dataset class that holds everything loaded from the data files.
+ */
+
+/**
+ * @class Dataset
+ * @brief The airports, airlines and flights graph loaded by the Parser, plus the indexes built from them.
+ *
+ * The Parser fills it once and then only hands it out as a const reference or a shared_ptr<const Dataset>,
+ * so every reader shares the same copy and nothing can change it behind their back.
+ * The only later addition is the contraction hierarchy of graph, installed by the first distance query that can use
+ * it (see Parser::loadHierarchy); it changes no answer, only how fast it is found.
+ */
+class Dataset {
+public:
+    Airport::AirportH airports;
+    Airline::AirlineH airlines;
+    Graph graph = Graph(0);
+
+    unordered_map<string, int> idAirports; ///< Airport code -> vertex id in graph.
+    unordered_set<string> countries;
+    unordered_set<string> cities;
+
+    Airport::CityH airportsPerCity;
+    unordered_map<string, list<string>> citiesPerCountry;
+};
+
+#endif //AIRBUSMANAGEMENTSYSTEM_DATASET_H
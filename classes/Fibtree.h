@@ -5,9 +5,7 @@
 #ifndef AIRBUSMANAGEMENTSYSTEM_FIBTREE_H
 #define AIRBUSMANAGEMENTSYSTEM_FIBTREE_H
 
-#include <iostream>
-#include <cmath>
-#include <unordered_map>
+#include <stdexcept>
 #include <vector>
 
 using namespace std;
@@ -16,35 +14,48 @@ using namespace std;
  * @brief Fibonacci Heap data structure implementation.
  *
  * This class implements a Fibonacci heap, a priority queue data structure
- * that supports efficient insertion, extraction of minimum key, and key decrease operations.
+ * that supports efficient insertion, extraction of minimum key, and key decrease operations.\n
+ * The nodes live in an arena owned by the heap (a vector, linked by indices instead of pointers) and the slots of
+ * extracted nodes are reused, so no node is allocated once the arena has grown. insert returns a Handle to the node,
+ * which decreaseKey and erase take, so they never have to look the item up.
  *
  * @tparam T Type of elements to be stored in the heap.
+ * @tparam Priority Type of the priorities the elements are ordered by.
  */
-template <typename T>
+template <typename T, typename Priority = double>
 class FibTree {
+public:
+    typedef int Handle; ///< Index of a node in the arena, valid until the node is extracted or erased.
+
 private:
+    static constexpr int NONE = -1; ///< Null node index.
+
     /**
      * @brief Node structure representing a node in the Fibonacci heap.
      */
     struct Node {
-        T key; ///< Key value of the node.
+        T item; ///< Element stored in the node.
+        Priority priority; ///< Priority of the element.
         int degree; ///< Degree of the node.
-        Node* parent; ///< Pointer to the parent node.
-        Node* child; ///< Pointer to the child node.
-        Node* left; ///< Pointer to the left sibling node.
-        Node* right; ///< Pointer to the right sibling node.
+        int parent; ///< Index of the parent node.
+        int child; ///< Index of one of the child nodes.
+        int left; ///< Index of the left sibling node.
+        int right; ///< Index of the right sibling node.
         bool marked; ///< Flag to mark if the node has lost a child.
-
-        /**
-         * @brief Constructor for the Node structure.
-         * @param k Key value of the node.
-         */
-        Node(T k) : key(k), degree(0), parent(nullptr), child(nullptr), left(this), right(this), marked(false) {}
     };
 
-    Node* minNode; ///< Pointer to the minimum node in the Fibonacci heap.
+    vector<Node> nodes; ///< Arena of the nodes.
+    vector<int> freeSlots; ///< Indices of the arena slots of extracted nodes.
+    int minNode; ///< Index of the minimum node in the Fibonacci heap.
     int numNodes; ///< Number of nodes in the Fibonacci heap.
-    std::unordered_map<T, Node*> nodeMap; ///< Map to store nodes using their keys.
+    vector<int> roots; ///< Scratch list of the roots, reused by consolidate.
+    vector<int> degreeRoots; ///< Scratch table of the root of each degree, reused by consolidate.
+
+    /**
+     * @brief Inserts a root node between minNode and its right sibling.
+     * @param node Node to be inserted.
+     */
+    void addRoot(int node);
 
     /**
      * @brief Consolidates the trees in the Fibonacci heap to ensure optimal structure.
@@ -52,30 +63,30 @@ private:
     void consolidate();
 
     /**
-     * @brief Links two nodes together in the Fibonacci heap.
-     * @param node1 First node to be linked.
-     * @param node2 Second node to be linked.
+     * @brief Links two roots together in the Fibonacci heap.
+     * @param node1 Root to become a child.
+     * @param node2 Root to become its parent.
      */
-    void link(Node* node1, Node* node2);
+    void link(int node1, int node2);
 
     /**
      * @brief Cuts a node from its parent in the Fibonacci heap.
      * @param node Node to be cut.
      * @param parent Parent node of the node to be cut.
      */
-    void cut(Node* node, Node* parent);
+    void cut(int node, int parent);
 
     /**
      * @brief Performs cascading cut operation in the Fibonacci heap.
      * @param node Node on which cascading cut is performed.
      */
-    void cascadingCut(Node* node);
+    void cascadingCut(int node);
 
     /**
-     * @brief Removes a node from the Fibonacci heap.
-     * @param node Node to be removed.
+     * @brief Removes the minimum node from the Fibonacci heap and frees its slot.
+     * @return The element of the minimum node.
      */
-    void removeNode(Node* node);
+    T removeMin();
 
 public:
     /**
@@ -84,9 +95,10 @@ public:
     FibTree();
 
     /**
-     * @brief Destructor for FibTree class.
+     * @brief Constructor that reserves the arena for n nodes.
+     * @param n Expected number of elements.
      */
-    ~FibTree();
+    explicit FibTree(int n);
 
     /**
      * @brief Checks if the Fibonacci heap is empty.
@@ -101,277 +113,291 @@ public:
     int size() const;
 
     /**
-     * @brief Inserts a new element into the Fibonacci heap.
-     * @param key Key value of the element to be inserted.
+     * @brief Inserts a new element into the Fibonacci heap.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(1)</b> amortized
+     * </pre>
+     * @param item Element to be inserted.
+     * @param priority Priority of the element.
+     * @return The handle of the element, for decreaseKey and erase.
      */
-    void insert(T key);
+    Handle insert(const T &item, const Priority &priority);
 
     /**
-     * @brief Extracts the minimum element from the Fibonacci heap.
-     * @return The minimum element of the heap.
+     * @brief Returns the smallest priority without removing its element.
+     * @note The heap must not be empty.
      */
-    T extractMin();
+    const Priority &minPriority() const;
 
     /**
-     * @brief Decreases the key of an element in the Fibonacci heap.
-     * @param oldKey Old key value of the element.
-     * @param newKey New key value to be set for the element.
+     * @brief Extracts the minimum element from the Fibonacci heap.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(log(N))</b> amortized, N -> number of elements in the heap
+     * </pre>
+     * @return The element with the smallest priority.
      */
-    void decreaseKey(T oldKey, T newKey);
+    T extractMin();
 
     /**
-     * @brief Checks if a key exists in the Fibonacci heap.
-     * @param key Key value to be checked.
-     * @return True if the key exists, otherwise false.
+     * @brief Decreases the priority of an element in the Fibonacci heap (a larger priority is ignored).\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(1)</b> amortized
+     * </pre>
+     * @param handle Handle returned by insert.
+     * @param priority New priority of the element.
      */
-    bool contains(T key);
+    void decreaseKey(Handle handle, const Priority &priority);
 
     /**
-     * @brief Erases an element with the specified key from the Fibonacci heap.
-     * @param key Key value of the element to be erased.
+     * @brief Erases an element from the Fibonacci heap.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(log(N))</b> amortized, N -> number of elements in the heap
+     * </pre>
+     * @param handle Handle returned by insert.
      */
-    void erase(T key);
+    void erase(Handle handle);
 
     /**
-     * @brief Clears the Fibonacci heap, removing all elements.
+     * @brief Clears the Fibonacci heap, removing all elements (the arena keeps its memory).
      */
     void clear();
 };
 
-template <typename T>
-FibTree<T>::FibTree() : minNode(nullptr), numNodes(0) {}
+template <typename T, typename Priority>
+FibTree<T, Priority>::FibTree() : minNode(NONE), numNodes(0) {}
 
-template <typename T>
-FibTree<T>::~FibTree() {
-    clear();
+template <typename T, typename Priority>
+FibTree<T, Priority>::FibTree(int n) : FibTree() {
+    nodes.reserve(n);
 }
 
-template <typename T>
-bool FibTree<T>::empty() const {
+template <typename T, typename Priority>
+bool FibTree<T, Priority>::empty() const {
     return numNodes == 0;
 }
 
-template <typename T>
-int FibTree<T>::size() const {
+template <typename T, typename Priority>
+int FibTree<T, Priority>::size() const {
     return numNodes;
 }
 
-template <typename T>
-void FibTree<T>::insert(T key) {
-
-    if (nodeMap.find(key) != nodeMap.end()) {
-        // Key already exists, handle accordingly
+template <typename T, typename Priority>
+void FibTree<T, Priority>::addRoot(int node) {
+    if (minNode == NONE) {
+        nodes[node].left = node;
+        nodes[node].right = node;
+        minNode = node;
         return;
     }
+    nodes[node].left = minNode;
+    nodes[node].right = nodes[minNode].right;
+    nodes[minNode].right = node;
+    nodes[nodes[node].right].left = node;
+}
 
-    Node* newNode = new Node(key);
-    if (minNode == nullptr) {
-        minNode = newNode;
+template <typename T, typename Priority>
+typename FibTree<T, Priority>::Handle FibTree<T, Priority>::insert(const T &item, const Priority &priority) {
+    Node node = {item, priority, 0, NONE, NONE, NONE, NONE, false};
+    int index;
+    if (freeSlots.empty()) {
+        index = (int)nodes.size();
+        nodes.push_back(node);
     } else {
-        newNode->left = minNode;
-        newNode->right = minNode->right;
-        minNode->right = newNode;
-        newNode->right->left = newNode;
-        if (newNode->key < minNode->key) {
-            minNode = newNode;
-        }
+        index = freeSlots.back();
+        freeSlots.pop_back();
+        nodes[index] = node;
     }
 
-    nodeMap[key] = newNode;
+    addRoot(index);
+    if (nodes[index].priority < nodes[minNode].priority)
+        minNode = index;
+
     ++numNodes;
+    return index;
 }
 
+template <typename T, typename Priority>
+const Priority &FibTree<T, Priority>::minPriority() const {
+    return nodes[minNode].priority;
+}
 
-template <typename T>
-void FibTree<T>::consolidate() {
-    int maxDegree = static_cast<int>(log2(numNodes)) + 1;
-    std::vector<Node*> degreeRoots(maxDegree, nullptr);
-    Node* current = minNode;
-    int numRoots = 0;
-
+template <typename T, typename Priority>
+void FibTree<T, Priority>::consolidate() {
+    // linking changes the root list, so the roots are collected before it is walked
+    roots.clear();
+    int start = minNode;
     do {
-        ++numRoots;
-        Node* next = current->right;
-        int degree = current->degree;
-        while (degreeRoots[degree] != nullptr) {
-            Node* other = degreeRoots[degree];
-            if (current->key > other->key) {
+        roots.push_back(start);
+        start = nodes[start].right;
+    } while (start != minNode);
+
+    for (int current : roots) {
+        int degree = nodes[current].degree;
+        while (degree < (int)degreeRoots.size() && degreeRoots[degree] != NONE) {
+            int other = degreeRoots[degree];
+            if (nodes[other].priority < nodes[current].priority) {
                 std::swap(current, other);
             }
             link(other, current);
-            degreeRoots[degree] = nullptr;
+            degreeRoots[degree] = NONE;
             degree++;
         }
+        if (degree >= (int)degreeRoots.size()) degreeRoots.resize(degree + 1, NONE);
         degreeRoots[degree] = current;
-        current = next;
-    } while (current != minNode);
-
-    minNode = nullptr;
-    for (int i = 0; i < maxDegree; ++i) {
-        if (degreeRoots[i] != nullptr) {
-            if (minNode == nullptr) {
-                minNode = degreeRoots[i];
-            } else {
-                degreeRoots[i]->left->right = degreeRoots[i]->right;
-                degreeRoots[i]->right->left = degreeRoots[i]->left;
-                degreeRoots[i]->left = minNode;
-                degreeRoots[i]->right = minNode->right;
-                minNode->right = degreeRoots[i];
-                degreeRoots[i]->right->left = degreeRoots[i];
-                if (degreeRoots[i]->key < minNode->key) {
-                    minNode = degreeRoots[i];
-                }
-            }
-        }
     }
-}
-
-template <typename T>
-void FibTree<T>::link(Node* node1, Node* node2) {
-    node1->left->right = node1->right;
 
-    // Check if node1->right is not nullptr before accessing its left pointer
-    if (node1->right != nullptr) {
-        node1->right->left = node1->left;
+    // every tree is a root of the list again: only the minimum has to be found
+    minNode = NONE;
+    for (int &root : degreeRoots) {
+        if (root == NONE) continue;
+        if (minNode == NONE || nodes[root].priority < nodes[minNode].priority)
+            minNode = root;
+        root = NONE;
     }
+}
 
-    node1->parent = node2;
+template <typename T, typename Priority>
+void FibTree<T, Priority>::link(int node1, int node2) {
+    Node &n1 = nodes[node1];
+    Node &n2 = nodes[node2];
+    nodes[n1.left].right = n1.right;
+    nodes[n1.right].left = n1.left;
 
-    if (node2->child == nullptr) {
-        node2->child = node1;
-        node1->left = node1;
-        node1->right = node1;
-    } else {
-        node1->left = node2->child;
-        node1->right = node2->child->right;
-        node2->child->right = node1;
+    n1.parent = node2;
 
-        // Check if node1->right is not nullptr before accessing its left pointer
-        if (node1->right != nullptr) {
-            node1->right->left = node1;
-        }
+    if (n2.child == NONE) {
+        n2.child = node1;
+        n1.left = node1;
+        n1.right = node1;
+    } else {
+        n1.left = n2.child;
+        n1.right = nodes[n2.child].right;
+        nodes[n2.child].right = node1;
+        nodes[n1.right].left = node1;
     }
 
-    node2->degree++;
-    node1->marked = false;
+    n2.degree++;
+    n1.marked = false;
 }
 
-template <typename T>
-void FibTree<T>::cut(Node* node, Node* parent) {
-    if (node == node->right) {
-        parent->child = nullptr;
+template <typename T, typename Priority>
+void FibTree<T, Priority>::cut(int node, int parent) {
+    Node &n = nodes[node];
+    Node &p = nodes[parent];
+    if (node == n.right) {
+        p.child = NONE;
     } else {
-        node->left->right = node->right;
-        node->right->left = node->left;
-        if (node == parent->child) {
-            parent->child = node->right;
+        nodes[n.left].right = n.right;
+        nodes[n.right].left = n.left;
+        if (node == p.child) {
+            p.child = n.right;
         }
     }
-    parent->degree--;
-    node->left = minNode;
-    node->right = minNode->right;
-    minNode->right = node;
-    node->right->left = node;
-    node->parent = nullptr;
-    node->marked = false;
+    p.degree--;
+    addRoot(node);
+    n.parent = NONE;
+    n.marked = false;
 }
 
-template <typename T>
-void FibTree<T>::cascadingCut(Node* node) {
-    Node* parent = node->parent;
-    if (parent != nullptr) {
-        if (!node->marked) {
-            node->marked = true;
-        } else {
-            cut(node, parent);
-            cascadingCut(parent);
+template <typename T, typename Priority>
+void FibTree<T, Priority>::cascadingCut(int node) {
+    int parent = nodes[node].parent;
+    while (parent != NONE) {
+        if (!nodes[node].marked) {
+            nodes[node].marked = true;
+            return;
         }
+        cut(node, parent);
+        node = parent;
+        parent = nodes[node].parent;
     }
 }
 
-template <typename T>
-void FibTree<T>::removeNode(Node* node) {
-    decreaseKey(node->key, std::numeric_limits<T>::min());
-    extractMin();
-}
-
-template <typename T>
-T FibTree<T>::extractMin() {
-    if (minNode == nullptr) {
-        throw std::logic_error("Heap is empty");
-    }
-
-    Node* extractedMin = minNode;
-    Node* child = extractedMin->child;
-    Node* tempChild;
+template <typename T, typename Priority>
+T FibTree<T, Priority>::removeMin() {
+    int extractedMin = minNode;
+    int child = nodes[extractedMin].child;
 
-    if (child != nullptr) {
-        tempChild = child;
+    if (child != NONE) {
+        int tempChild = child;
         do {
-            tempChild->parent = nullptr;
-            tempChild = tempChild->right;
+            nodes[tempChild].parent = NONE;
+            tempChild = nodes[tempChild].right;
         } while (tempChild != child);
+
+        // the children become roots
+        int last = nodes[child].left;
+        nodes[last].right = nodes[extractedMin].right;
+        nodes[nodes[extractedMin].right].left = last;
+        nodes[extractedMin].right = child;
+        nodes[child].left = extractedMin;
+        nodes[extractedMin].child = NONE;
     }
 
-    if (extractedMin->right == extractedMin) {
-        minNode = nullptr;
+    if (nodes[extractedMin].right == extractedMin) {
+        minNode = NONE;
     } else {
-        extractedMin->left->right = extractedMin->right;
-        extractedMin->right->left = extractedMin->left;
-        minNode = extractedMin->right;
+        nodes[nodes[extractedMin].left].right = nodes[extractedMin].right;
+        nodes[nodes[extractedMin].right].left = nodes[extractedMin].left;
+        minNode = nodes[extractedMin].right;
         consolidate();
     }
 
-    T minKey = extractedMin->key;
-    nodeMap.erase(minKey);
-    delete extractedMin;
+    freeSlots.push_back(extractedMin);
     --numNodes;
 
-    return minKey;
+    return nodes[extractedMin].item;
 }
 
-template <typename T>
-void FibTree<T>::decreaseKey(T oldKey, T newKey) {
-    if (nodeMap.find(oldKey) == nodeMap.end()) {
-        // Key does not exist in the heap
-        return;
+template <typename T, typename Priority>
+T FibTree<T, Priority>::extractMin() {
+    if (minNode == NONE) {
+        throw std::logic_error("Heap is empty");
     }
+    return removeMin();
+}
 
-    Node* node = nodeMap[oldKey];
-    if (newKey > oldKey) {
-        // New key is greater than old key
+template <typename T, typename Priority>
+void FibTree<T, Priority>::decreaseKey(Handle handle, const Priority &priority) {
+    Node &node = nodes[handle];
+    if (node.priority < priority) {
+        // New priority is greater than the old one
         return;
     }
 
-    node->key = newKey;
-    Node* parent = node->parent;
-    if (parent != nullptr && node->key < parent->key) {
-        cut(node, parent);
+    node.priority = priority;
+    int parent = node.parent;
+    if (parent != NONE && node.priority < nodes[parent].priority) {
+        cut(handle, parent);
         cascadingCut(parent);
     }
 
-    if (node->key < minNode->key)
-        minNode = node;
-
+    if (node.priority < nodes[minNode].priority)
+        minNode = handle;
 }
 
-template <typename T>
-bool FibTree<T>::contains(T key) {
-    return nodeMap.find(key) != nodeMap.end();
-}
-
-template <typename T>
-void FibTree<T>::erase(T key) {
-    if (nodeMap.find(key) != nodeMap.end()) {
-        Node* node = nodeMap[key];
-        removeNode(node);
+template <typename T, typename Priority>
+void FibTree<T, Priority>::erase(Handle handle) {
+    // the node is moved to the root list and taken as the minimum, whatever its priority
+    int parent = nodes[handle].parent;
+    if (parent != NONE) {
+        cut(handle, parent);
+        cascadingCut(parent);
     }
+    minNode = handle;
+    removeMin();
 }
 
-template <typename T>
-void FibTree<T>::clear() {
-    while (minNode != nullptr)
-        extractMin();
+template <typename T, typename Priority>
+void FibTree<T, Priority>::clear() {
+    nodes.clear();
+    freeSlots.clear();
+    minNode = NONE;
+    numNodes = 0;
 }
 
 
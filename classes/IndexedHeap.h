@@ -0,0 +1,179 @@
+#ifndef AIRBUSMANAGEMENTSYSTEM_INDEXEDHEAP_H
+#define AIRBUSMANAGEMENTSYSTEM_INDEXEDHEAP_H
+
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains the IndexedHeap class, the priority queue of the graph searches.
+ */
+
+/**
+ * @class IndexedHeap
+ * @brief D-ary min-heap of dense integer keys (vertex ids) with values (priorities) of type Value.
+ *
+ * The position of every key is kept in a flat vector indexed by the key, instead of a hash map, and the sifts move
+ * a hole down or up the tree and write the moving node once, instead of swapping at every level.
+ * With D = 4 the tree is half as deep as a binary heap and the children of a node share a cache line.\n
+ * reset() only clears the keys still queued, so one heap serves many searches without reallocating.
+ * @tparam Value Priority type.
+ * @tparam D Number of children of each node.
+ */
+template <class Value, int D = 4>
+class IndexedHeap {
+    static_assert(D >= 2, "a heap node needs at least two children");
+
+    struct Node { // An element of the heap: a pair (key, value)
+        int key;
+        Value value;
+    };
+
+    std::vector<Node> heapArray;  // The heap array, root at index 0
+    std::vector<int> positions;   // positions[key] = index of key in heapArray, -1 if not queued
+
+    /**
+     * Moves node up from the hole at index until its parent is not greater, then writes it there.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(log_D N)</b>, N -> number of elements in the heap
+     * </pre>
+     */
+    void siftUp(int index, Node node);
+
+    /**
+     * Moves node down from the hole at index until no child is smaller, then writes it there.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(D*log_D N)</b>, N -> number of elements in the heap
+     * </pre>
+     */
+    void siftDown(int index, Node node);
+
+public:
+    static constexpr int KEY_NOT_FOUND = -1; ///< Returned by extractMin when the heap is empty.
+
+    /**
+     * @brief Constructor for an empty heap of the keys 0..n-1.
+     * @param n Number of keys.
+     */
+    explicit IndexedHeap(int n = 0) : positions(n, -1) {}
+
+    /**
+     * @brief Empties the heap and makes room for the keys 0..n-1.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(N)</b>, N -> number of elements still in the heap (O(n) only when it grows)
+     * </pre>
+     * @param n Number of keys.
+     */
+    void reset(int n);
+
+    [[nodiscard]] int getSize() const {return (int)heapArray.size();}
+    [[nodiscard]] bool empty() const {return heapArray.empty();}
+
+    /**
+     * @brief Checks if a key is queued.
+     */
+    [[nodiscard]] bool contains(int key) const {return positions[key] != -1;}
+
+    /**
+     * @brief Inserts a key that is not queued.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(log_D N)</b>, N -> number of elements in the heap
+     * </pre>
+     */
+    void insert(int key, const Value &value);
+
+    /**
+     * @brief Lowers the value of a queued key (a larger value is ignored).\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(log_D N)</b>, N -> number of elements in the heap
+     * </pre>
+     */
+    void decreaseKey(int key, const Value &value);
+
+    /**
+     * @brief Removes and returns the key with the smallest value.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(D*log_D N)</b>, N -> number of elements in the heap
+     * </pre>
+     * @return The key, or KEY_NOT_FOUND if the heap is empty.
+     */
+    int extractMin();
+
+    /**
+     * @brief Returns the smallest value in the heap without removing it.
+     * @note The heap must not be empty.
+     */
+    [[nodiscard]] const Value &minValue() const {return heapArray[0].value;}
+};
+
+template <class Value, int D>
+void IndexedHeap<Value, D>::siftUp(int index, Node node) {
+    while (index > 0) {
+        int parent = (index - 1) / D;
+        if (!(node.value < heapArray[parent].value)) break;
+        heapArray[index] = heapArray[parent];
+        positions[heapArray[index].key] = index;
+        index = parent;
+    }
+    heapArray[index] = node;
+    positions[node.key] = index;
+}
+
+template <class Value, int D>
+void IndexedHeap<Value, D>::siftDown(int index, Node node) {
+    int size = (int)heapArray.size();
+    while (true) {
+        int first = index * D + 1;
+        if (first >= size) break;
+        int last = first + D < size ? first + D : size;
+        int child = first;
+        for (int c = first + 1; c < last; c++)
+            if (heapArray[c].value < heapArray[child].value) child = c;
+        if (!(heapArray[child].value < node.value)) break;
+        heapArray[index] = heapArray[child];
+        positions[heapArray[index].key] = index;
+        index = child;
+    }
+    heapArray[index] = node;
+    positions[node.key] = index;
+}
+
+template <class Value, int D>
+void IndexedHeap<Value, D>::reset(int n) {
+    for (const Node &node : heapArray) positions[node.key] = -1;
+    heapArray.clear();
+    if ((int)positions.size() < n) positions.resize(n, -1);
+}
+
+template <class Value, int D>
+void IndexedHeap<Value, D>::insert(int key, const Value &value) {
+    if (contains(key)) return; // The key already exists, do nothing
+    heapArray.push_back({key, value});
+    siftUp((int)heapArray.size() - 1, {key, value});
+}
+
+template <class Value, int D>
+void IndexedHeap<Value, D>::decreaseKey(int key, const Value &value) {
+    if (!contains(key)) return; // The key does not exist, do nothing
+    int index = positions[key];
+    if (heapArray[index].value < value) return; // The value would increase, do nothing
+    siftUp(index, {key, value});
+}
+
+template <class Value, int D>
+int IndexedHeap<Value, D>::extractMin() {
+    if (heapArray.empty()) return KEY_NOT_FOUND;
+    int minKey = heapArray[0].key;
+    positions[minKey] = -1;
+    Node last = heapArray.back();
+    heapArray.pop_back();
+    if (!heapArray.empty()) siftDown(0, last);
+    return minKey;
+}
+
+#endif //AIRBUSMANAGEMENTSYSTEM_INDEXEDHEAP_H
@@ -0,0 +1,101 @@
+#ifndef AIRBUSMANAGEMENTSYSTEM_INTERNER_H
+#define AIRBUSMANAGEMENTSYSTEM_INTERNER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+#include <limits>
+
+using namespace std;
+
+/**
+ * @file
+ * @brief Contains the Interner class that maps codes (IATA/ICAO) into dense integer ids.
+ */
+
+/**
+ * @brief Interning table that gives every distinct code a dense id (0, 1, 2, ...) in order of appearance.
+ *
+ * Codes are hashed only once, at load time; afterwards the ids can be stored, compared and used as array indexes,
+ * and the string is only resolved again (in O(1)) when it has to be printed.
+ *
+ * @tparam Id Unsigned integer type of the ids.
+ */
+template <typename Id>
+class Interner {
+private:
+    /**
+     * @brief Transparent hash, so a string_view can be searched without building a string.
+     */
+    struct CodeHash {
+        using is_transparent = void;
+        size_t operator()(string_view code) const {return hash<string_view>()(code);}
+    };
+
+    unordered_map<string, Id, CodeHash, equal_to<>> ids; ///< Maps a code into its id.
+    vector<string> codes;          ///< Maps an id into its code.
+
+public:
+    static constexpr Id NOT_FOUND = numeric_limits<Id>::max(); ///< Id returned when a code was never interned.
+
+    /**
+     * @brief Returns the id of the code, assigning the next free id if the code is new.
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(1)</b> average
+     * </pre>
+     * @param code Code to intern.
+     * @return Dense id of the code.
+     */
+    Id intern(string_view code);
+
+    /**
+     * @brief Searches the id of a code without interning it.
+     * @param code Code to search.
+     * @return Id of the code, or NOT_FOUND if the code was never interned.
+     */
+    [[nodiscard]] Id find(string_view code) const;
+
+    /**
+     * @brief Resolves an id back into its code.
+     * @param id Id previously returned by intern.
+     * @return The code of the id.
+     */
+    [[nodiscard]] const string &getCode(Id id) const;
+
+    /**
+     * @brief Returns the number of interned codes, which is also the first unused id.
+     */
+    [[nodiscard]] int size() const;
+};
+
+template <typename Id>
+Id Interner<Id>::intern(string_view code) {
+    auto it = ids.find(code);
+    if (it != ids.end()) return it->second;
+
+    Id id = (Id)codes.size();
+    ids.insert({string(code), id});
+    codes.emplace_back(code);
+    return id;
+}
+
+template <typename Id>
+Id Interner<Id>::find(string_view code) const {
+    auto it = ids.find(code);
+    return it == ids.end() ? NOT_FOUND : it->second;
+}
+
+template <typename Id>
+const string &Interner<Id>::getCode(Id id) const {
+    return codes[id];
+}
+
+template <typename Id>
+int Interner<Id>::size() const {
+    return (int)codes.size();
+}
+
+#endif //AIRBUSMANAGEMENTSYSTEM_INTERNER_H
@@ -0,0 +1,30 @@
+#include "MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const string &path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat info{};
+    if (fstat(fd, &info) == 0) {
+        if (info.st_size == 0) {
+            opened = true;
+        } else {
+            void *mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                bytes = static_cast<const char *>(mapping);
+                length = info.st_size;
+                opened = true;
+            }
+        }
+    }
+    close(fd); // the mapping stays valid after the descriptor is closed
+}
+
+MappedFile::~MappedFile() {
+    if (length > 0) munmap(const_cast<char *>(bytes), length);
+}
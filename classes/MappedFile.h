@@ -0,0 +1,59 @@
+#ifndef AIRBUSMANAGEMENTSYSTEM_MAPPEDFILE_H
+#define AIRBUSMANAGEMENTSYSTEM_MAPPEDFILE_H
+
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+/**
+ * @file
+ * @brief Contains the MappedFile class, a read-only memory mapping of a whole file.
+ */
+
+/**
+ * @class MappedFile
+ * @brief Maps a file into memory (read-only) for as long as the object lives.
+ *
+ * The bytes are read straight from the page cache: nothing is copied into a buffer of the process.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Maps the file; isOpen() tells if it succeeded.
+     * @param path Path of the file.
+     */
+    explicit MappedFile(const string &path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+     * @brief Checks if the file was opened and mapped.
+     */
+    [[nodiscard]] bool isOpen() const {return opened;}
+
+    /**
+     * @brief Gets the first byte of the file.
+     */
+    [[nodiscard]] const char *data() const {return bytes;}
+
+    /**
+     * @brief Gets the size of the file in bytes.
+     */
+    [[nodiscard]] size_t size() const {return length;}
+
+    /**
+     * @brief Gets the whole file as a string_view over the mapping.
+     */
+    [[nodiscard]] string_view view() const {return {bytes, length};}
+
+private:
+    const char *bytes = ""; ///< Start of the mapping (an empty string for an empty file).
+    size_t length = 0;      ///< Size of the mapping in bytes.
+    bool opened = false;    ///< True if the file was opened.
+};
+
+#endif //AIRBUSMANAGEMENTSYSTEM_MAPPEDFILE_H
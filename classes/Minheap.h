@@ -101,6 +101,13 @@ public:
      * @note Removes and returns the key with the smallest value in the heap.
      */
     Key extractMin(); // Remove and return key with the smallest value. Time Complexity: O(log N)
+
+    /**
+     * @brief Returns the smallest value in the heap without removing it.
+     * @note The heap must not be empty.
+     */
+    const Value &minValue() const {return heapArray[1].value;}
+
     /**
      * @brief Checks if the Fibonacci heap is empty.
      * @return True if the heap is empty, otherwise false.
@@ -196,6 +203,7 @@ Key MinHeap<Key, Value>::extractMin() {
     Key minKey = heapArray[1].key;
     positions.erase(minKey);
     heapArray[1] = heapArray[heapSize--];
+    if (heapSize > 0) positions[heapArray[1].key] = 1; // the last node moved to the root
     bubbleDown(1);
     return minKey;
 }
@@ -1,36 +1,72 @@
 #include "Parser.h"
+#include "MappedFile.h"
+#include "CsvReader.h"
 #include <chrono>
 #include <thread>
 #include <vector>
-#include <mutex>
 
-Parser::Parser() {
+atomic<int> Parser::constructions = 0;
+
+Parser::Parser(bool parallel) {
+    ++constructions;
     auto start = std::chrono::steady_clock::now();
 
-    createAirports();
-    createAirlines();
+    sourceChecksum = Snapshot::checksum({AIRPORTS_FILE, AIRLINES_FILE, FLIGHTS_FILE});
+    bool fromSnapshot = Snapshot::read(*this, SNAPSHOT_FILE, sourceChecksum);
+    if (!fromSnapshot) {
+        createAirports();
+        createAirlines();
 
-    cout << graph.getNumVertex() << endl;
-    createGraphGeneric();
+        cout << data->graph.getNumVertex() << endl;
+        if (parallel) createGraph();
+        else createGraphGeneric();
+    }
     auto end = std::chrono::steady_clock::now();
 
     // Calculate the duration in milliseconds
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
 
     // Output the duration
-    std::cout << "CreateGraph execution time: " << duration.count() << " milliseconds" << std::endl;
-    cout << graph.getNumVertex() << endl;
+    std::cout << (fromSnapshot ? "Snapshot load" : "CreateGraph") << " execution time: " << duration.count() << " milliseconds" << std::endl;
+    cout << data->graph.getNumVertex() << endl;
+
+    if (!fromSnapshot && !Snapshot::write(*this, SNAPSHOT_FILE, sourceChecksum))
+        cout << "Could not write " << SNAPSHOT_FILE << endl;
+}
+
+int Parser::getConstructions() {return constructions;}
 
+Landmarks Parser::loadLandmarks(int k) const {
+    Landmarks landmarks;
+    if (landmarks.load(LANDMARKS_FILE, sourceChecksum, data->graph.getNumVertex(), k))
+        return landmarks;
+
+    landmarks = Landmarks(data->graph, k);
+    if (!landmarks.save(LANDMARKS_FILE, sourceChecksum))
+        cout << "Could not write " << LANDMARKS_FILE << endl;
+    return landmarks;
 }
 
-Airport::AirportH const& Parser::getAirports() const {return airports;}
-Airline::AirlineH const& Parser::getAirlines() const {return airlines;}
-Airport::CityH const& Parser::getCity() const {return airportsPerCity;}
-Graph Parser::getGraph() const {return graph;}
-unordered_map<string,int> Parser::getMap() const{
-    return idAirports;
+void Parser::loadHierarchy() {
+    if (data->graph.isContracted()) return;
+    auto hierarchy = make_shared<ContractionHierarchy>();
+    if (!hierarchy->load(HIERARCHY_FILE, sourceChecksum, data->graph.getNumVertex())) {
+        *hierarchy = ContractionHierarchy(data->graph);
+        if (!hierarchy->save(HIERARCHY_FILE, sourceChecksum))
+            cout << "Could not write " << HIERARCHY_FILE << endl;
+    }
+    data->graph.setHierarchy(std::move(hierarchy));
 }
 
+Airport::AirportH const& Parser::getAirports() const {return data->airports;}
+Airline::AirlineH const& Parser::getAirlines() const {return data->airlines;}
+Airport::CityH const& Parser::getCity() const {return data->airportsPerCity;}
+Graph const& Parser::getGraph() const {return data->graph;}
+unordered_map<string,int> const& Parser::getMap() const{
+    return data->idAirports;
+}
+shared_ptr<const Dataset> Parser::getDataset() const {return data;}
+
 /**
  * Swaps key and value.\n\n
  * <b>Complexity\n</b>
@@ -63,132 +99,133 @@ multimap<int,string> Parser::convertMap(const map<string, int>& m) {
 
 
 void Parser::createAirports() {
-    ifstream in;
-    string currentLine, code, name, city, country, x;
-    double latitude, longitude;
+    MappedFile file(AIRPORTS_FILE);
+    CsvReader csv(file.view());
+    string_view line;
     int i = 0;
-    in.open("../data/airports.csv");
-    getline(in, currentLine);
-
-    while (getline(in,currentLine)) {
-        istringstream iss(currentLine);
-
-        getline(iss, code, ',');
-        getline(iss, name, ',');
-        getline(iss, city, ',');
-        getline(iss, country, ',');
-        getline(iss, x, ',');
-        latitude = stod(x);
-        getline(iss, x, ',');
-        longitude = stod(x);
-
-        Airport airport = Airport(code, name, city, country, latitude, longitude);
-        graph.addAirport(i,airport);
-        airportsPerCity[{airport.getCountry(),airport.getCity()}].push_back(code);
-        idAirports.insert({airport.getCode(),i++});
-        airports.insert(airport);
-        countries.insert(country);
-        cities.insert(city);
-        citiesPerCountry[country].push_back(city);
+    csv.skipLine();
+
+    while (csv.nextLine(line)) {
+        string code(CsvReader::nextField(line));
+        string name(CsvReader::nextField(line));
+        string city(CsvReader::nextField(line));
+        string country(CsvReader::nextField(line));
+        double latitude = CsvReader::toDouble(CsvReader::nextField(line));
+        double longitude = CsvReader::toDouble(CsvReader::nextField(line));
+
+        addAirport(i++, Airport(std::move(code), std::move(name), std::move(city), std::move(country), latitude, longitude));
     }
 }
 
+void Parser::addAirport(int id, const Airport &airport) {
+    data->graph.addAirport(id, airport);
+    data->airportsPerCity[{airport.getCountry(),airport.getCity()}].push_back(airport.getCode());
+    data->idAirports.insert({airport.getCode(),id});
+    data->airports.insert(airport);
+    data->countries.insert(airport.getCountry());
+    data->cities.insert(airport.getCity());
+    data->citiesPerCountry[airport.getCountry()].push_back(airport.getCity());
+}
+
 void Parser::createAirlines() {
-    ifstream in;
-    string code, name, callSign, country, line;
-    in.open("../data/airlines.csv");
-    getline(in, line);
-    while(getline(in, line)){
-        istringstream is(line);
-        getline(is,code,',');
-        getline(is,name,',');
-        getline(is,callSign,',');
-        getline(is,country,',');
-        Airline a = Airline(code, name, callSign, country);
-        airlines.insert(a);
+    MappedFile file(AIRLINES_FILE);
+    CsvReader csv(file.view());
+    string_view line;
+    csv.skipLine();
+    while (csv.nextLine(line)) {
+        string_view code = CsvReader::nextField(line);
+        string_view name = CsvReader::nextField(line);
+        string_view callSign = CsvReader::nextField(line);
+        string_view country = CsvReader::nextField(line);
+        Airline::intern(code);
+        data->airlines.insert(Airline(string(code), string(name), string(callSign), string(country)));
     }
 }
 
-std::mutex mtx;
-
-void Parser::processEdges(const std::vector<std::string>& lines) {
-    for (const auto& line : lines) {
-        std::istringstream is(line);
-        std::string source, target, airline;
-
-        std::getline(is, source, ',');
-        std::getline(is, target, ',');
-        std::getline(is, airline, ',');
-
-        double latSource = airports.find(Airport(source))->getLatitude();
-        double lonSource = airports.find(Airport(source))->getLongitude();
-
-        double latTarget = airports.find(Airport(target))->getLatitude();
-        double lonTarget = airports.find(Airport(target))->getLongitude();
+/**
+ * Read-only lookups used while parsing flights.csv, shared by every loader thread.
+ */
+struct Parser::AirportIndex {
+    unordered_map<string_view, int> ids;      // code -> vertex id, views of the idAirports keys
+    vector<pair<double, double>> coordinates; // vertex id -> (latitude, longitude)
+};
+
+Parser::AirportIndex Parser::indexAirports() const {
+    AirportIndex index;
+    index.coordinates.resize(data->graph.getNumVertex());
+    for (const auto &[code, id] : data->idAirports) index.ids.insert({code, id});
+    for (const Airport &a : data->airports) index.coordinates[data->idAirports.at(a.getCode())] = {a.getLatitude(), a.getLongitude()};
+    return index;
+}
 
+void Parser::parseFlights(string_view text, const AirportIndex &index, EdgeList &flights, UnknownAirlines &unknown) {
+    CsvReader csv(text);
+    string_view line;
+    flights.reserve(csv.countLines());
+    while (csv.nextLine(line)) {
+        auto source = index.ids.find(CsvReader::nextField(line));
+        auto target = index.ids.find(CsvReader::nextField(line));
+        string_view code = CsvReader::nextField(line);
+        if (source == index.ids.end() || target == index.ids.end()) continue;
+
+        // only reads the interner, the codes that are not there yet are interned after the threads join
+        Airline::Id airline = Airline::idOf(code);
+        if (airline == Airline::NOT_FOUND) unknown.emplace_back(flights.size(), code);
+
+        auto [latSource, lonSource] = index.coordinates[source->second];
+        auto [latTarget, lonTarget] = index.coordinates[target->second];
         double d = Graph::haversineDistanceGeneric(latSource, lonSource, latTarget, lonTarget);
 
-        std::lock_guard<std::mutex> lock(mtx);
-        graph.addFlight(idAirports[source], idAirports[target], Airline(airline), d);
+        flights.push(source->second, target->second, d, airline);
     }
 }
 
-void Parser::createGraph() {
-    std::ifstream in("../data/flights.csv");
-    std::string line;
-    std::vector<std::string> allLines;
-    std::vector<std::thread> threads;
-    const int numThreads = std::thread::hardware_concurrency();
-
-    std::getline(in, line); // Skip header
-
-    while (std::getline(in, line)) {
-        allLines.push_back(line);
-    }
-
-    const int totalLines = allLines.size();
-    const int idealChunkSize = totalLines / numThreads;
-    const int minChunkSize = 100; // Minimum chunk size
-
-    int start = 0;
-    int end = std::min(idealChunkSize, totalLines); // Initial chunk size
-
-    while (start < totalLines) {
-        if (end - start < minChunkSize || end >= totalLines) {
-            end = totalLines;
-        }
-
-        std::vector<std::string> lines(allLines.begin() + start, allLines.begin() + end);
-
-        threads.emplace_back([this, lines]() { this->processEdges(lines); });
+void Parser::buildGraph(vector<EdgeList> &parts, vector<UnknownAirlines> &unknown) {
+    // interned in file order, so the ids are the same whatever the number of parts
+    for (size_t p = 0; p < parts.size(); p++)
+        for (const auto &[edge, code] : unknown[p])
+            parts[p].airline[edge] = Airline::intern(code);
+    data->graph.freeze(parts);
+}
 
+void Parser::createGraph() {
+    AirportIndex index = indexAirports();
+    MappedFile file(FLIGHTS_FILE);
+    string_view text = file.view();
+    text.remove_prefix(min(text.find('\n') + 1, text.size())); // Skip header
+
+    const size_t minChunkSize = 64 * 1024; // Minimum chunk size in bytes
+    size_t numThreads = max<size_t>(1, min<size_t>(thread::hardware_concurrency(), text.size() / minChunkSize));
+
+    // every chunk ends right after a newline, so no line is split between two threads
+    vector<string_view> chunks;
+    size_t start = 0;
+    for (size_t t = 1; t <= numThreads && start < text.size(); t++) {
+        size_t end = t == numThreads ? text.size() : max(start, text.size() * t / numThreads);
+        end = end < text.size() ? min(text.find('\n', end), text.size() - 1) + 1 : text.size();
+        chunks.push_back(text.substr(start, end - start));
         start = end;
-        end = std::min(start + idealChunkSize, totalLines);
     }
 
-    for (auto& thread : threads) {
+    vector<EdgeList> parts(chunks.size());
+    vector<UnknownAirlines> unknown(chunks.size());
+    vector<thread> threads;
+    for (size_t t = 0; t < chunks.size(); t++)
+        threads.emplace_back([&, t]() { parseFlights(chunks[t], index, parts[t], unknown[t]); });
+    for (auto &thread : threads)
         thread.join();
-    }
-}
-void Parser::createGraphGeneric(){
-    ifstream in;
-    string source, target, airline, line;
-    in.open("../data/flights.csv");
-    getline(in, line);
-    while(getline(in, line)){
-        istringstream is(line);
-        getline(is,source,',');
-        getline(is,target,',');
-        getline(is,airline,',');
-
-        double latSource = airports.find(Airport(source))->getLatitude();
-        double lonSource = airports.find(Airport(source))->getLongitude();
 
-        double latTarget = airports.find(Airport(target))->getLatitude();
-        double lonTarget = airports.find(Airport(target))->getLongitude();
-
-        auto d = Graph::haversineDistanceGeneric(latSource, lonSource, latTarget, lonTarget);
+    buildGraph(parts, unknown);
+}
 
-        graph.addFlight(idAirports[source],idAirports[target],Airline(airline),d);
-    }
-}
\ No newline at end of file
+void Parser::createGraphGeneric(){
+    AirportIndex index = indexAirports();
+    MappedFile file(FLIGHTS_FILE);
+    string_view text = file.view();
+    text.remove_prefix(min(text.find('\n') + 1, text.size())); // Skip header
+
+    vector<EdgeList> parts(1);
+    vector<UnknownAirlines> unknown(1);
+    parseFlights(text, index, parts[0], unknown[0]);
+    buildGraph(parts, unknown);
+}
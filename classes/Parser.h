@@ -10,20 +10,84 @@
 #include <fstream>
 #include <istream>
 #include <sstream>
+#include <string_view>
+#include <atomic>
 #include "airport.h"
 #include "airline.h"
+#include "Snapshot.h"
+#include "Dataset.h"
+#include "../network/landmarks.h"
+#include "../network/contraction_hierarchy.h"
 #include "../network/graph.h"
 using namespace std;
 
 
 class Parser {
 public:
-    Parser();
+    static constexpr const char *AIRPORTS_FILE = "../data/airports.csv";
+    static constexpr const char *AIRLINES_FILE = "../data/airlines.csv";
+    static constexpr const char *FLIGHTS_FILE = "../data/flights.csv";
+    static constexpr const char *SNAPSHOT_FILE = "../data/graph.snapshot"; ///< Binary Snapshot of the three files.
+    static constexpr const char *LANDMARKS_FILE = "../data/landmarks.snapshot"; ///< Saved Landmarks tables.
+    static constexpr const char *HIERARCHY_FILE = "../data/hierarchy.snapshot"; ///< Saved ContractionHierarchy.
+
+    /**
+     * Loads the airports, airlines and flights from the Snapshot when it was built from the current CSV files,
+     * otherwise reads the CSV files and writes a new Snapshot for the next launches.
+     * The contraction hierarchy of the graph is not built here, only by the first loadHierarchy call\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|V|+|E|)</b> from the snapshot, see createGraphGeneric for the CSV files
+     * </pre>
+     * @param parallel - read flights.csv with one thread per core (createGraph) instead of createGraphGeneric
+     */
+    explicit Parser(bool parallel = false);
+
+    /**
+     * Gets how many Parser objects were constructed so far. Every construction loads the whole dataset again,
+     * so answering a query must leave this number unchanged\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(1)</b>
+     * </pre>
+     */
+    static int getConstructions();
+
+    /**
+     * Gets the loaded data, to share it with objects that outlive the parser\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(1)</b>
+     * </pre>
+     */
+    [[nodiscard]] shared_ptr<const Dataset> getDataset() const;
+
+    /**
+     * Gets the ALT Landmarks of the graph: read from LANDMARKS_FILE when it was saved for the same data files and k,
+     * otherwise computed and saved there for the next runs\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(k*|V|)</b> when saved, <b>O(k*|E|log(|V|))</b> otherwise
+     * </pre>
+     * @param k - number of landmarks
+     */
+    [[nodiscard]] Landmarks loadLandmarks(int k) const;
+
+    /**
+     * Installs in the graph its ContractionHierarchy, unless it already has one: read from HIERARCHY_FILE when it
+     * was saved for the same data files, otherwise contracted and saved there for the next runs.
+     * Only the distance queries without airline filter use it, so they call this on first use\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(1)</b> when installed, <b>O(|V|+|E|)</b> when saved, see ContractionHierarchy otherwise
+     * </pre>
+     */
+    void loadHierarchy();
     Airport::AirportH const& getAirports() const;
     Airline::AirlineH const& getAirlines() const;
     Airport::CityH const &getCity() const;
-    Graph getGraph() const;
-    unordered_map<string,int> getMap() const;
+    Graph const &getGraph() const;
+    unordered_map<string,int> const &getMap() const;
 
     /**
      * Transforms the map into a multimap and swaps it information\n\n
@@ -38,18 +102,26 @@ public:
     */
     static multimap<int,string> convertMap(const map<string,int>& m);
 
-    Airport::AirportH airports;
-    Airline::AirlineH airlines;
-    Graph graph = Graph(0);
+protected:
+    shared_ptr<Dataset> data = make_shared<Dataset>(); ///< Only written while loading, shared as const afterwards.
 
-    unordered_map<string, int> idAirports;//graph
-    unordered_set<string> countries;
-    unordered_set<string> cities;
+private:
+    friend class Snapshot;
 
-    Airport::CityH airportsPerCity;
-    unordered_map<string, list<string>> citiesPerCountry;
+    static atomic<int> constructions; ///< Number of Parser objects constructed.
+    uint64_t sourceChecksum = 0;      ///< Snapshot::checksum of the data files that were loaded.
 
-private:
+    /**
+     * Adds an airport to the graph (with the given vertex id) and to airports, airportsPerCity, idAirports,
+     * cities, countries and citiesPerCountry\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(1)</b> average
+     * </pre>
+     * @param id - vertex id of the airport
+     * @param airport
+     */
+    void addAirport(int id, const Airport &airport);
 
     /**
      * Reads airports.csv file and stores the airports information in airportsPerCity, idAirports, airports, cities, countries,
@@ -62,7 +134,7 @@ private:
     void createAirports();
 
     /**
-     * Reads airlines.csv file and stores the information in airlines\n\n
+     * Reads airlines.csv file, stores the information in airlines and interns the airline codes into dense ids\n\n
      *  * <b>Complexity\n</b>
      * <pre>
      *      <b>O(n)</b>, n is the number of file lines
@@ -71,20 +143,60 @@ private:
     void createAirlines();
 
     /**
-     * Reads flights.csv file and stores the airports information in graphs about the flights
-     * (airport of departure/arrival and distance between them)\n\n
+     * Reads flights.csv (memory mapped, fields as string_view slices, no allocation per line) and builds the frozen
+     * adjacency of the graph, with the haversine distance of every flight\n\n
      * <b>Complexity\n</b>
      * <pre>
-     *      <b>O(n*log(n))</b>, n is the numbers of file lines
+     *      <b>O(n+|V|)</b>, n is the numbers of file lines
      * </pre>
      */
     void createGraphGeneric();
 
+    /**
+     * Parallel version of createGraphGeneric: the mapped file is split at line boundaries into one chunk per core,
+     * each thread parses its chunk into its own EdgeList and the lists are merged by Graph::freeze with a counting
+     * sort by source, so no lock is taken per flight. The graph is the same as the one of createGraphGeneric.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(n/t+|V|)</b>, n is the numbers of file lines, t the number of threads
+     * </pre>
+     */
     void createGraph();
 
+    struct AirportIndex;
+    typedef vector<pair<size_t, string_view>> UnknownAirlines; ///< (edge index, code) of the airlines not interned yet
 
-    void processEdges(const std::vector<std::string>& lines);
+    /**
+     * Builds the code and coordinates lookups of the loaded airports\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|V|)</b>
+     * </pre>
+     */
+    [[nodiscard]] AirportIndex indexAirports() const;
+
+    /**
+     * Parses whole lines of flights.csv into flights; it does not change any shared state, so several chunks can
+     * be parsed at the same time\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(n)</b>, n is the number of lines of the chunk
+     * </pre>
+     * @param text - lines to parse, without the header
+     * @param index - lookups of indexAirports
+     * @param flights - receives the flights, in file order
+     * @param unknown - receives the airline codes not interned yet
+     */
+    static void parseFlights(string_view text, const AirportIndex &index, EdgeList &flights, UnknownAirlines &unknown);
 
+    /**
+     * Interns the unknown airlines in file order and freezes the graph with the parsed flights\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|V|+|E|)</b>
+     * </pre>
+     */
+    void buildGraph(vector<EdgeList> &parts, vector<UnknownAirlines> &unknown);
 };
 
 
@@ -0,0 +1,183 @@
+#ifndef AIRBUSMANAGEMENTSYSTEM_RADIXHEAP_H
+#define AIRBUSMANAGEMENTSYSTEM_RADIXHEAP_H
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains the RadixHeap class, a monotone priority queue for Dijkstra.
+ */
+
+/**
+ * @class RadixHeap
+ * @brief Monotone radix heap of vertices with non-negative double keys.
+ *
+ * Dijkstra never queues a key below the last one extracted, and a radix heap uses exactly that: an entry lives in
+ * the bucket numbered by the highest bit in which its key differs from the last extracted key, so finding the
+ * minimum only scans the first non-empty bucket and pushes its entries into lower buckets, each entry moving down
+ * at most 64 times in total.\n
+ * The keys are the flown kilometres themselves, as the bits of a non-negative IEEE-754 double, read as an unsigned
+ * integer, sort in the same order as the double: no rounding to metres is needed and the distances stay exact.\n
+ * A decreaseKey pushes a new entry and the stale one is skipped when it comes out, as in
+ * SearchQueue::DUPLICATES. The interface is the one of IndexedHeap, so Graph::dijkstra can be instantiated with it.
+ */
+class RadixHeap {
+public:
+    static constexpr int KEY_NOT_FOUND = -1; ///< Returned by extractMin when the heap is empty.
+
+    /**
+     * @brief Constructor for an empty heap of the vertices 0..n-1.
+     */
+    explicit RadixHeap(int n = 0) {reset(n);}
+
+    /**
+     * @brief Empties the heap and makes room for the vertices 0..n-1.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(N)</b>, N -> number of entries still queued (O(n) only when it grows)
+     * </pre>
+     */
+    void reset(int n);
+
+    [[nodiscard]] bool empty() const {return live == 0;}
+    [[nodiscard]] bool contains(int key) const {return queued[key];}
+
+    /**
+     * @brief Queues a vertex that is not queued; value must not be below the last extracted value.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(1)</b>
+     * </pre>
+     */
+    void insert(int key, double value);
+
+    /**
+     * @brief Lowers the value of a queued vertex (a larger value is ignored).\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(1)</b>
+     * </pre>
+     */
+    void decreaseKey(int key, double value);
+
+    /**
+     * @brief Removes and returns the vertex with the smallest value.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(log C)</b> amortized, C -> range of the keys (64 bits)
+     * </pre>
+     * @return The vertex, or KEY_NOT_FOUND if the heap is empty.
+     */
+    int extractMin();
+
+    /**
+     * @brief Returns the smallest value without removing it.
+     * @note The heap must not be empty.
+     */
+    double minValue();
+
+private:
+    struct Entry {
+        uint64_t bits;  // the value as an unsigned integer
+        int key;
+    };
+
+    std::vector<Entry> buckets[65]; // bucket i holds the keys whose highest bit different from last is bit i - 1
+    uint64_t last = 0;              // last extracted value, every queued value is >= last
+    int live = 0;                   // number of queued vertices
+    std::vector<uint64_t> latest;   // value of the live entry of each vertex
+    std::vector<bool> queued;       // the vertex has a live entry
+
+    static uint64_t toBits(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    static double toValue(uint64_t bits) {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    [[nodiscard]] int bucketOf(uint64_t bits) const {return std::bit_width(bits ^ last);}
+
+    [[nodiscard]] bool isStale(const Entry &e) const {return !queued[e.key] || latest[e.key] != e.bits;}
+
+    /**
+     * Makes the back of bucket 0 a live entry holding the minimum.
+     */
+    void settle();
+};
+
+inline void RadixHeap::reset(int n) {
+    for (auto &bucket : buckets) {
+        for (const Entry &e : bucket) queued[e.key] = false;
+        bucket.clear();
+    }
+    last = 0;
+    live = 0;
+    if ((int)queued.size() < n) {
+        latest.resize(n);
+        queued.resize(n, false);
+    }
+}
+
+inline void RadixHeap::insert(int key, double value) {
+    if (queued[key]) return; // The key already exists, do nothing
+    uint64_t bits = toBits(value);
+    queued[key] = true;
+    latest[key] = bits;
+    live++;
+    buckets[bucketOf(bits)].push_back({bits, key});
+}
+
+inline void RadixHeap::decreaseKey(int key, double value) {
+    uint64_t bits = toBits(value);
+    if (!queued[key] || latest[key] < bits) return;
+    latest[key] = bits; // the older entry is stale from now on
+    buckets[bucketOf(bits)].push_back({bits, key});
+}
+
+inline void RadixHeap::settle() {
+    while (true) {
+        while (!buckets[0].empty() && isStale(buckets[0].back())) buckets[0].pop_back();
+        if (!buckets[0].empty()) return;
+
+        int i = 1;
+        while (buckets[i].empty()) i++;
+
+        // the smallest live value of bucket i becomes last, its entries now differ from it in lower bits only
+        uint64_t smallest = UINT64_MAX;
+        for (const Entry &e : buckets[i])
+            if (!isStale(e) && e.bits < smallest) smallest = e.bits;
+        if (smallest == UINT64_MAX) { // only stale entries
+            buckets[i].clear();
+            continue;
+        }
+        last = smallest;
+        for (const Entry &e : buckets[i])
+            if (!isStale(e)) buckets[bucketOf(e.bits)].push_back(e);
+        buckets[i].clear();
+    }
+}
+
+inline int RadixHeap::extractMin() {
+    if (live == 0) return KEY_NOT_FOUND;
+    settle();
+    int key = buckets[0].back().key;
+    buckets[0].pop_back();
+    queued[key] = false;
+    live--;
+    return key;
+}
+
+inline double RadixHeap::minValue() {
+    settle();
+    return toValue(buckets[0].back().bits);
+}
+
+#endif //AIRBUSMANAGEMENTSYSTEM_RADIXHEAP_H
@@ -0,0 +1,77 @@
+#include "SearchQueue.h"
+
+#include <algorithm>
+#include <functional>
+
+/**
+ * @file
+ * @brief Contains the SearchQueue class implementation
+ */
+SearchQueue::SearchQueue(int n) : heap(n), latest(n), queued(n, false) {}
+
+void SearchQueue::reset(int n) {
+    heap.reset(n);
+    for (const Entry &e : entries) queued[e.key] = false;
+    entries.clear();
+    if ((int)queued.size() < n) {
+        latest.resize(n);
+        queued.resize(n, false);
+    }
+}
+
+void SearchQueue::dropStale() {
+    while (!entries.empty() && (!queued[entries.front().key] || latest[entries.front().key] != entries.front().value)) {
+        pop_heap(entries.begin(), entries.end(), greater<>());
+        entries.pop_back();
+    }
+}
+
+bool SearchQueue::empty() {
+    if (mode == DECREASE_KEY) return heap.empty();
+    dropStale();
+    return entries.empty();
+}
+
+bool SearchQueue::contains(int key) const {
+    return mode == DECREASE_KEY ? heap.contains(key) : (bool)queued[key];
+}
+
+void SearchQueue::insert(int key, double value) {
+    if (mode == DECREASE_KEY) {
+        heap.insert(key, value);
+        return;
+    }
+    if (queued[key]) return; // The key already exists, do nothing
+    queued[key] = true;
+    latest[key] = value;
+    entries.push_back({value, key});
+    push_heap(entries.begin(), entries.end(), greater<>());
+}
+
+void SearchQueue::decreaseKey(int key, double value) {
+    if (mode == DECREASE_KEY) {
+        heap.decreaseKey(key, value);
+        return;
+    }
+    if (!queued[key] || latest[key] < value) return;
+    latest[key] = value; // the older entry is stale from now on
+    entries.push_back({value, key});
+    push_heap(entries.begin(), entries.end(), greater<>());
+}
+
+int SearchQueue::extractMin() {
+    if (mode == DECREASE_KEY) return heap.extractMin();
+    dropStale();
+    if (entries.empty()) return -1;
+    int key = entries.front().key;
+    pop_heap(entries.begin(), entries.end(), greater<>());
+    entries.pop_back();
+    queued[key] = false;
+    return key;
+}
+
+double SearchQueue::minValue() {
+    if (mode == DECREASE_KEY) return heap.minValue();
+    dropStale();
+    return entries.front().value;
+}
@@ -0,0 +1,117 @@
+#ifndef AIRBUSMANAGEMENTSYSTEM_SEARCHQUEUE_H
+#define AIRBUSMANAGEMENTSYSTEM_SEARCHQUEUE_H
+
+#include <vector>
+#include "IndexedHeap.h"
+
+using namespace std;
+
+/**
+ * @file
+ * @brief Contains the SearchQueue class, the priority queue of the graph searches.
+ */
+
+/**
+ * @class SearchQueue
+ * @brief Priority queue of vertices with two disciplines, selectable at runtime.
+ *
+ * Either way only the vertices a search discovers enter the queue.
+ * <ul>
+ *   <li>DECREASE_KEY keeps one entry per vertex in an IndexedHeap and moves it up when the key improves.</li>
+ *   <li>DUPLICATES pushes a new entry at every improvement into a plain binary heap and skips the stale ones
+ *       (an entry whose key is no longer the latest of its vertex) when they reach the top: no position
+ *       bookkeeping, at the price of a larger heap.</li>
+ * </ul>
+ * The interface is the one of IndexedHeap, so a search is written once for both.
+ */
+class SearchQueue {
+public:
+    /**
+     * @brief How improvements of a queued key are handled.
+     */
+    enum Mode {
+        DECREASE_KEY, ///< One entry per vertex, moved up (the default).
+        DUPLICATES    ///< One entry per improvement, stale entries skipped.
+    };
+
+    /**
+     * @brief Constructor for an empty queue of the vertices 0..n-1.
+     */
+    explicit SearchQueue(int n = 0);
+
+    void setMode(Mode m) {mode = m;}
+    [[nodiscard]] Mode getMode() const {return mode;}
+
+    /**
+     * @brief Empties the queue and makes room for the vertices 0..n-1 (keeps the mode).\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(N)</b>, N -> number of entries still queued (O(n) only when it grows)
+     * </pre>
+     */
+    void reset(int n);
+
+    /**
+     * @brief Checks if there is no live entry left.
+     */
+    bool empty();
+
+    /**
+     * @brief Checks if a vertex has a live entry.
+     */
+    [[nodiscard]] bool contains(int key) const;
+
+    /**
+     * @brief Queues a vertex that is not queued.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(log N)</b>, N -> number of entries
+     * </pre>
+     */
+    void insert(int key, double value);
+
+    /**
+     * @brief Lowers the key of a queued vertex (a larger value is ignored).\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(log N)</b>, N -> number of entries
+     * </pre>
+     */
+    void decreaseKey(int key, double value);
+
+    /**
+     * @brief Removes and returns the vertex with the smallest key.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(log N)</b> amortized, N -> number of entries
+     * </pre>
+     * @return The vertex, or -1 if the queue is empty.
+     */
+    int extractMin();
+
+    /**
+     * @brief Returns the smallest key without removing it.
+     * @note The queue must not be empty.
+     */
+    double minValue();
+
+private:
+    struct Entry {
+        double value;
+        int key;
+        bool operator>(const Entry &other) const {return value > other.value;}
+    };
+
+    Mode mode = DECREASE_KEY;
+    IndexedHeap<double> heap;  // DECREASE_KEY
+    vector<Entry> entries;     // DUPLICATES: binary min-heap of every pushed entry
+    vector<double> latest;     // DUPLICATES: key of the live entry of each vertex
+    vector<bool> queued;       // DUPLICATES: the vertex has a live entry
+
+    /**
+     * Pops the stale entries from the top of entries.
+     */
+    void dropStale();
+};
+
+#endif //AIRBUSMANAGEMENTSYSTEM_SEARCHQUEUE_H
@@ -0,0 +1,198 @@
+#include "Snapshot.h"
+#include "MappedFile.h"
+#include "Parser.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+static const char MAGIC[8] = {'A', 'B', 'M', 'S', 'N', 'A', 'P', '\0'};
+
+/**
+ * Rounds n up to a multiple of 8.\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(1)</b>
+ * </pre>
+ */
+static uint64_t align8(uint64_t n) {
+    return (n + 7) & ~uint64_t(7);
+}
+
+uint64_t Snapshot::fnv1a(const char *bytes, size_t size, uint64_t hash) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= (unsigned char)bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t Snapshot::checksum(const vector<string> &paths) {
+    uint64_t hash = FNV_OFFSET;
+    for (const string &path : paths) {
+        MappedFile file(path);
+        hash = fnv1a(file.data(), file.size(), hash);
+        hash = fnv1a("\n", 1, hash); // separates the files, so moving bytes between them changes the checksum
+    }
+    return hash;
+}
+
+Snapshot::Layout Snapshot::layout(const Header &header) {
+    Layout l{};
+    l.stringOffsets = align8(sizeof(Header));
+    l.stringChars = align8(l.stringOffsets + (uint64_t(header.nrStrings) + 1) * sizeof(uint32_t));
+    l.airports = align8(l.stringChars + header.stringBytes);
+    l.airlines = align8(l.airports + uint64_t(header.nrAirports) * sizeof(AirportRecord));
+    l.csrOffsets = align8(l.airlines + uint64_t(header.nrAirlines) * sizeof(AirlineRecord));
+    l.csrDest = align8(l.csrOffsets + (uint64_t(header.nrVertices) + 1) * sizeof(int));
+    l.csrWeight = align8(l.csrDest + uint64_t(header.nrEdges) * sizeof(int));
+    l.csrAirline = align8(l.csrWeight + uint64_t(header.nrEdges) * sizeof(double));
+    l.total = align8(l.csrAirline + uint64_t(header.nrEdges) * sizeof(Airline::Id));
+    return l;
+}
+
+bool Snapshot::write(const Parser &parser, const string &path, uint64_t sourceChecksum) {
+    vector<string> strings;
+    unordered_map<string, uint32_t> stringIds;
+    auto addString = [&](const string &s) {
+        auto it = stringIds.find(s);
+        if (it != stringIds.end()) return it->second;
+        auto id = (uint32_t)strings.size();
+        stringIds.insert({s, id});
+        strings.push_back(s);
+        return id;
+    };
+
+    const Graph &graph = parser.data->graph;
+    vector<AirportRecord> airports;
+    airports.reserve(graph.getNumVertex());
+    for (Vertex *v : graph.getVertexSet()) {
+        Airport a = v->getAirport();
+        airports.push_back({a.getLatitude(), a.getLongitude(),
+                            addString(a.getCode()), addString(a.getName()), addString(a.getCity()), addString(a.getCountry())});
+    }
+
+    vector<AirlineRecord> airlines;
+    airlines.reserve(Airline::nrIds());
+    for (int id = 0; id < Airline::nrIds(); id++) {
+        const string &code = Airline::codeOf(id);
+        auto it = parser.data->airlines.find(Airline(code));
+        if (it == parser.data->airlines.end())
+            airlines.push_back({addString(code), addString(""), addString(""), addString(""), 0});
+        else
+            airlines.push_back({addString(code), addString(it->getName()), addString(it->getCallSign()),
+                                addString(it->getCountry()), 1});
+    }
+
+    const CSR &csr = graph.getCSR();
+
+    Header header{};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.nrStrings = strings.size();
+    header.sourceChecksum = sourceChecksum;
+    for (const string &s : strings) header.stringBytes += s.size();
+    header.nrAirports = airports.size();
+    header.nrAirlines = airlines.size();
+    header.nrVertices = graph.getNumVertex();
+    header.nrEdges = csr.dest.size();
+
+    Layout l = layout(header);
+    vector<char> buffer(l.total, 0);
+
+    auto *offsets = reinterpret_cast<uint32_t *>(&buffer[l.stringOffsets]);
+    uint32_t offset = 0;
+    for (size_t i = 0; i < strings.size(); i++) {
+        offsets[i] = offset;
+        memcpy(&buffer[l.stringChars + offset], strings[i].data(), strings[i].size());
+        offset += strings[i].size();
+    }
+    offsets[strings.size()] = offset;
+
+    memcpy(&buffer[l.airports], airports.data(), airports.size() * sizeof(AirportRecord));
+    memcpy(&buffer[l.airlines], airlines.data(), airlines.size() * sizeof(AirlineRecord));
+    memcpy(&buffer[l.csrOffsets], csr.offsets.data(), csr.offsets.size() * sizeof(int));
+    memcpy(&buffer[l.csrDest], csr.dest.data(), csr.dest.size() * sizeof(int));
+    memcpy(&buffer[l.csrWeight], csr.weight.data(), csr.weight.size() * sizeof(double));
+    memcpy(&buffer[l.csrAirline], csr.airline.data(), csr.airline.size() * sizeof(Airline::Id));
+
+    header.payloadChecksum = fnv1a(&buffer[sizeof(Header)], buffer.size() - sizeof(Header), FNV_OFFSET);
+    memcpy(buffer.data(), &header, sizeof(Header));
+
+    // written aside and renamed, so a reader never maps a half written snapshot
+    string tmp = path + ".tmp";
+    {
+        ofstream out(tmp, ios::binary | ios::trunc);
+        if (!out.write(buffer.data(), (streamsize)buffer.size())) return false;
+    }
+    return rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+bool Snapshot::read(Parser &parser, const string &path, uint64_t sourceChecksum) {
+    MappedFile file(path);
+    if (!file.isOpen() || file.size() < sizeof(Header)) return false;
+
+    Header header{};
+    memcpy(&header, file.data(), sizeof(Header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) return false;
+    if (header.sourceChecksum != sourceChecksum) return false;
+    if (header.nrVertices != header.nrAirports) return false;
+
+    Layout l = layout(header);
+    if (l.total != file.size()) return false;
+    if (fnv1a(file.data() + sizeof(Header), file.size() - sizeof(Header), FNV_OFFSET)
+        != header.payloadChecksum) return false;
+
+    const char *base = file.data();
+    auto *offsets = reinterpret_cast<const uint32_t *>(base + l.stringOffsets);
+    const char *chars = base + l.stringChars;
+    auto *airports = reinterpret_cast<const AirportRecord *>(base + l.airports);
+    auto *airlines = reinterpret_cast<const AirlineRecord *>(base + l.airlines);
+    auto *csrOffsets = reinterpret_cast<const int *>(base + l.csrOffsets);
+    auto *csrDest = reinterpret_cast<const int *>(base + l.csrDest);
+    auto *csrWeight = reinterpret_cast<const double *>(base + l.csrWeight);
+    auto *csrAirline = reinterpret_cast<const Airline::Id *>(base + l.csrAirline);
+
+    for (uint32_t i = 0; i < header.nrStrings; i++)
+        if (offsets[i] > offsets[i + 1]) return false;
+    if (offsets[header.nrStrings] != header.stringBytes) return false;
+    auto str = [&](uint32_t id) {return string(chars + offsets[id], offsets[id + 1] - offsets[id]);};
+
+    for (uint32_t i = 0; i < header.nrAirports; i++) {
+        const AirportRecord &a = airports[i];
+        if (max({a.code, a.name, a.city, a.country}) >= header.nrStrings) return false;
+    }
+    for (uint32_t i = 0; i < header.nrAirlines; i++) {
+        const AirlineRecord &a = airlines[i];
+        if (max({a.code, a.name, a.callSign, a.country}) >= header.nrStrings) return false;
+        // ids already interned (by an earlier load) must keep their meaning
+        if (i < (uint32_t)Airline::nrIds() && Airline::codeOf(i) != str(a.code)) return false;
+    }
+    if (csrOffsets[0] != 0 || csrOffsets[header.nrVertices] != (int)header.nrEdges) return false;
+    for (uint32_t v = 0; v < header.nrVertices; v++)
+        if (csrOffsets[v] > csrOffsets[v + 1]) return false;
+    for (uint32_t e = 0; e < header.nrEdges; e++)
+        if (csrDest[e] < 0 || csrDest[e] >= (int)header.nrVertices || csrAirline[e] >= header.nrAirlines) return false;
+
+    // the snapshot is valid, from here on the parser is filled
+    for (uint32_t i = 0; i < header.nrAirlines; i++) {
+        const AirlineRecord &a = airlines[i];
+        string code = str(a.code);
+        Airline::intern(code);
+        if (a.listed) parser.data->airlines.insert(Airline(code, str(a.name), str(a.callSign), str(a.country)));
+    }
+
+    for (uint32_t i = 0; i < header.nrAirports; i++) {
+        const AirportRecord &a = airports[i];
+        parser.addAirport((int)i, Airport(str(a.code), str(a.name), str(a.city), str(a.country), a.latitude, a.longitude));
+    }
+
+    CSR csr;
+    csr.offsets.assign(csrOffsets, csrOffsets + header.nrVertices + 1);
+    csr.dest.assign(csrDest, csrDest + header.nrEdges);
+    csr.weight.assign(csrWeight, csrWeight + header.nrEdges);
+    csr.airline.assign(csrAirline, csrAirline + header.nrEdges);
+    parser.data->graph.freeze(std::move(csr));
+    return true;
+}
@@ -0,0 +1,130 @@
+#ifndef AIRBUSMANAGEMENTSYSTEM_SNAPSHOT_H
+#define AIRBUSMANAGEMENTSYSTEM_SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class Parser;
+
+/**
+ * @file
+ * @brief Contains the Snapshot class, a binary image of the data loaded by the Parser.
+ */
+
+/**
+ * @class Snapshot
+ * @brief Writes and reads a versioned binary snapshot of the airports, airlines and flights graph.
+ *
+ * Reading the snapshot skips the CSV parsing, the airport lookups of every flight and the haversine distances:
+ * the file is mapped into memory and its arrays are copied as they are.\n
+ * Layout (native endianness, every section aligned to 8 bytes):
+ * <pre>
+ *      Header
+ *      string table: uint32 offsets[nrStrings + 1], chars[stringBytes]
+ *      AirportRecord[nrAirports]        (vertex id order)
+ *      AirlineRecord[nrAirlines]        (interned id order)
+ *      CSR: int32 offsets[nrVertices + 1], int32 dest[nrEdges], double weight[nrEdges], uint16 airline[nrEdges]
+ * </pre>
+ * The header keeps a checksum of the CSV files the snapshot was built from, so a snapshot of older data is
+ * ignored, and a checksum of the payload, so a truncated or damaged file is ignored too.
+ */
+class Snapshot {
+public:
+    static constexpr uint32_t VERSION = 1; ///< Bumped whenever the layout changes.
+
+    /**
+     * @brief Computes the FNV-1a checksum of the contents of the files.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(n)</b>, n -> total size of the files
+     * </pre>
+     * @param paths Files to checksum (a missing file counts as empty).
+     * @return The checksum.
+     */
+    static uint64_t checksum(const vector<string> &paths);
+
+    /**
+     * @brief Writes the data of the parser into a snapshot file.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|V|+|E|+S)</b>, S -> total size of the strings
+     * </pre>
+     * @param parser Parser with the data already loaded and the graph frozen.
+     * @param path Path of the snapshot.
+     * @param sourceChecksum Checksum of the CSV files the data was read from.
+     * @return true if the file was written.
+     */
+    static bool write(const Parser &parser, const string &path, uint64_t sourceChecksum);
+
+    /**
+     * @brief Loads the parser from a snapshot file.
+     * Nothing is changed in the parser unless the snapshot is complete, of the current version and built from
+     * the same CSV files.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|V|+|E|+S)</b>, S -> total size of the strings
+     * </pre>
+     * @param parser Empty parser to fill.
+     * @param path Path of the snapshot.
+     * @param sourceChecksum Checksum of the current CSV files.
+     * @return true if the parser was loaded, false if the CSV files must be read instead.
+     */
+    static bool read(Parser &parser, const string &path, uint64_t sourceChecksum);
+
+    static constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL; ///< Initial value of an FNV-1a checksum.
+
+    /**
+     * @brief Continues an FNV-1a checksum over more bytes.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(n)</b>, n -> size
+     * </pre>
+     * @param bytes Bytes to add.
+     * @param size Number of bytes.
+     * @param hash Checksum so far (FNV_OFFSET to start one).
+     * @return The updated checksum.
+     */
+    static uint64_t fnv1a(const char *bytes, size_t size, uint64_t hash);
+
+private:
+    /**
+     * @brief First bytes of the file.
+     */
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t nrStrings;
+        uint64_t sourceChecksum;
+        uint64_t payloadChecksum;   // checksum of every byte after the header
+        uint64_t stringBytes;
+        uint32_t nrAirports;
+        uint32_t nrAirlines;
+        uint32_t nrVertices;
+        uint32_t nrEdges;
+    };
+
+    struct AirportRecord {
+        double latitude;
+        double longitude;
+        uint32_t code, name, city, country; // indexes in the string table
+    };
+
+    struct AirlineRecord {
+        uint32_t code, name, callSign, country; // indexes in the string table
+        uint32_t listed;                        // 1 if the airline is in airlines.csv, 0 if only a flight uses it
+    };
+
+    /**
+     * @brief Byte offset of every section, computed from the counts of the header.
+     */
+    struct Layout {
+        uint64_t stringOffsets, stringChars, airports, airlines, csrOffsets, csrDest, csrWeight, csrAirline, total;
+    };
+
+    static Layout layout(const Header &header);
+};
+
+#endif //AIRBUSMANAGEMENTSYSTEM_SNAPSHOT_H
@@ -1,56 +1,57 @@
 
 #include "Utils.h"
 
+#include <algorithm>
+#include <unordered_set>
 #include <utility>
 
-Utils::Utils(){
+Utils::Utils(bool parallel) : Parser(parallel) {
     countAirportsPerCountry();
 }
 
 
 
 bool Utils::isCountry(const string& country){
-    auto i = countries.find(country);
-    if (i == countries.end()) return false;
+    auto i = data->countries.find(country);
+    if (i == data->countries.end()) return false;
     return true;
 }
 
 bool Utils::isAirport(const Airport& airport){
-    auto i = airports.find(airport);
-    if (i == airports.end()) return false;
+    auto i = data->airports.find(airport);
+    if (i == data->airports.end()) return false;
     return true;
 }
 
 bool Utils::isAirline(const Airline& airline) {
-    auto i = airlines.find(airline);
-    if (i == airlines.end()) return false;
+    auto i = data->airlines.find(airline);
+    if (i == data->airlines.end()) return false;
     return true;
 }
 
 bool Utils::isCity(const string& city) {
-    auto i = cities.find(city);
-    if (i == cities.end()) return false;
+    auto i = data->cities.find(city);
+    if (i == data->cities.end()) return false;
     return true;
 }
 
 bool Utils::isValidCity(const string& country, const string& city) {
-    for (const auto& c : citiesPerCountry[country])
+    auto cities = data->citiesPerCountry.find(country);
+    if (cities == data->citiesPerCountry.end()) return false;
+    for (const auto& c : cities->second)
         if (city == c) return true;
     return false;
 }
 
 int Utils::nrFlights(){
-    int nrFlights = 0;
-    for (const auto& node: graph.getVertexSet())
-        nrFlights += node->getAdj().size();
-    return nrFlights;
+    return data->graph.getNumEdges();
 }
 
 
 vector<string> Utils::localAirports(double latitude, double longitude, double radius) const {
     vector<string> localAirports;
     double latitude1,longitude1;
-    for (const auto& node : graph.getVertexSet()){
+    for (const auto& node : data->graph.getVertexSet()){
         latitude1 = node->getAirport().getLatitude();
         longitude1 = node->getAirport().getLongitude();
         if (Graph::haversineDistanceGeneric(latitude,longitude,latitude1,longitude1) <= radius)
@@ -59,51 +60,193 @@ vector<string> Utils::localAirports(double latitude, double longitude, double ra
     return localAirports;
 }
 
+vector<int> Utils::airportIds(const vector<string>& codes) const {
+    vector<int> ids;
+    ids.reserve(codes.size());
+    for (const auto &code : codes)
+        ids.push_back(data->idAirports.at(code));
+    return ids;
+}
+
+bool Utils::overlap(const vector<string>& src, const vector<string>& dest) {
+    unordered_set<string> sources(src.begin(), src.end());
+    for (const auto &d : dest)
+        if (sources.count(d)) return true;
+    return false;
+}
+
+list<pair<string,string>> Utils::toCodes(const vector<pair<int,int>>& pairs, const vector<string>& src,
+                                         const vector<string>& dest) const {
+    unordered_map<int,int> srcIndex, destIndex;
+    for (int i = (int)src.size() - 1; i >= 0; i--) srcIndex[data->idAirports.at(src[i])] = i;
+    for (int j = (int)dest.size() - 1; j >= 0; j--) destIndex[data->idAirports.at(dest[j])] = j;
+
+    vector<pair<int,int>> indexes;
+    for (auto [s, d] : pairs) indexes.emplace_back(srcIndex.at(s), destIndex.at(d));
+    sort(indexes.begin(), indexes.end()); // the order of the pairwise loops
+
+    list<pair<string,string>> res;
+    for (auto [i, j] : indexes) res.emplace_back(src[i], dest[j]);
+    return res;
+}
+
 list<pair<string,string>> Utils::processFlight(int& bestFlight, const vector<string>& src, const vector<string>& dest,
-                                               const Airline::AirlineH& airline) {
+                                               const AirlineMask& airline) {
+    SearchContext context(data->graph.getNumVertex());
+    if (!overlap(src, dest)) {
+        vector<pair<int,int>> pairs;
+        bestFlight = data->graph.nearestFlights(context, airportIds(src), airportIds(dest), airline, pairs);
+        return toCodes(pairs, src, dest);
+    }
+
+    // an airport on both sides is skipped as a pair, yet may be reached from the others: one bfs per source
     bestFlight = INT_MAX;
-    int nrFlights;
     list<pair<string,string>> res;
-    for (const auto &s: src)
-        for (const auto &d: dest) {
-            if (s == d) continue;
-            nrFlights = graph.nrFlights(idAirports[s], idAirports[d], airline);
+    vector<vector<int>> flights = data->graph.flightsMatrix(context, airportIds(src), airportIds(dest), airline);
+    for (size_t i = 0; i < src.size(); i++)
+        for (size_t j = 0; j < dest.size(); j++) {
+            if (src[i] == dest[j]) continue;
+            int nrFlights = flights[i][j];
             if (nrFlights != 0 && nrFlights < bestFlight) {
                 bestFlight = nrFlights;
                 res.clear();
-                res.emplace_back(s,d);
+                res.emplace_back(src[i],dest[j]);
             }
             else if(nrFlights == bestFlight)
-                res.emplace_back(s,d);
+                res.emplace_back(src[i],dest[j]);
         }
     return res;
 }
 
 list<pair<string,string>> Utils::processDistance(double& bestDistance, const vector<string>& src, const vector<string>& dest,
-                                                      const Airline::AirlineH& airline) {
+                                                      const AirlineMask& airline) {
+    if (airline.allowsAll()) loadHierarchy(); // for distanceMatrix here and Graph::printPathsByDistance afterwards
+    SearchContext context(data->graph.getNumVertex());
+    if (!overlap(src, dest)) {
+        vector<pair<int,double>> sources, targets;
+        for (int s : airportIds(src)) sources.emplace_back(s, 0);
+        for (int d : airportIds(dest)) targets.emplace_back(d, 0);
+        vector<pair<int,int>> pairs;
+        bestDistance = data->graph.nearestDistance(context, sources, targets, airline, pairs);
+        if (bestDistance != SearchContext::INF)
+            return toCodes(pairs, src, dest);
+
+        // no route at all: every pair is reported, so that each one is shown as without flights
+        list<pair<string,string>> res;
+        for (const auto &s : src)
+            for (const auto &d : dest) res.emplace_back(s, d);
+        return res;
+    }
+
+    // an airport on both sides is skipped as a pair, yet may be reached from the others: the full matrix
     bestDistance = MAXFLOAT;
-    double distance;
     list<pair<string,string>> res;
-    for (const auto &s: src)
-        for (const auto &d: dest) {
-            if (s == d) continue;
-            auto node = graph.dijkstra(idAirports[s], idAirports[d], airline);
-            distance = node->getDistance();
+    vector<vector<double>> distances = data->graph.distanceMatrix(context, airportIds(src), airportIds(dest), airline);
+    for (size_t i = 0; i < src.size(); i++)
+        for (size_t j = 0; j < dest.size(); j++) {
+            if (src[i] == dest[j]) continue;
+            double distance = distances[i][j];
             if (distance < bestDistance) {
                 bestDistance = distance;
                 res.clear();
-                res.emplace_back(s,d);
+                res.emplace_back(src[i],dest[j]);
             }
             else if (distance == bestDistance)
-                res.emplace_back(s,d);
+                res.emplace_back(src[i],dest[j]);
+        }
+    return res;
+}
+
+
+int Utils::processChanges(double& distance, vector<int>& path, vector<Airline::Id>& legs, const vector<string>& src,
+                          const vector<string>& dest, const AirlineMask& airline) {
+    SearchContext context;
+    if (!overlap(src, dest))
+        return data->graph.fewestAirlineChanges(context, airportIds(src), airportIds(dest), airline, distance, path, legs);
+
+    // an airport on both sides is skipped as a pair: one search per source, without it among the targets
+    int bestChanges = INT_MAX;
+    distance = SearchContext::INF;
+    vector<int> targets, p;
+    vector<Airline::Id> l;
+    for (const auto &s : src) {
+        targets.clear();
+        for (const auto &d : dest)
+            if (d != s) targets.push_back(data->idAirports.at(d));
+        double d;
+        int changes = data->graph.fewestAirlineChanges(context, {data->idAirports.at(s)}, targets, airline, d, p, l);
+        if (changes < bestChanges || (changes == bestChanges && d < distance)) {
+            bestChanges = changes;
+            distance = d;
+            path = p;
+            legs = l;
         }
+    }
+    return bestChanges;
+}
+
+
+vector<pair<int, double>> Utils::processPareto(vector<vector<int>>& paths, const vector<string>& src,
+                                               const vector<string>& dest, const AirlineMask& airline) {
+    SearchContext context(data->graph.getNumVertex());
+    if (!overlap(src, dest))
+        return data->graph.paretoRoutes(context, airportIds(src), airportIds(dest), airline, paths);
+
+    // an airport on both sides is skipped as a pair: one search per source, without it among the targets,
+    // then the frontier of all the points found
+    vector<tuple<int, double, vector<int>>> points;
+    vector<int> targets;
+    vector<vector<int>> p;
+    for (const auto &s : src) {
+        targets.clear();
+        for (const auto &d : dest)
+            if (d != s) targets.push_back(data->idAirports.at(d));
+        auto frontier = data->graph.paretoRoutes(context, {data->idAirports.at(s)}, targets, airline, p);
+        for (size_t i = 0; i < frontier.size(); i++)
+            points.emplace_back(frontier[i].first, frontier[i].second, std::move(p[i]));
+    }
+    sort(points.begin(), points.end());
+
+    vector<pair<int, double>> res;
+    paths.clear();
+    for (auto &[flights, km, path] : points) {
+        if (!res.empty() && km >= res.back().second) continue; // as long as a route with fewer flights
+        res.emplace_back(flights, km);
+        paths.push_back(std::move(path));
+    }
+    return res;
+}
+
+
+vector<pair<double, list<pair<string,string>>>> Utils::processHopLimited(int maxFlights, const vector<string>& src,
+                                                                         const vector<string>& dest,
+                                                                         const AirlineMask& airline) {
+    vector<pair<double, list<pair<string,string>>>> res(max(0, maxFlights), {SearchContext::INF, {}});
+    vector<int> targets = airportIds(dest);
+    for (const auto &s : src) {
+        auto distances = data->graph.hopLimitedDistances(data->idAirports.at(s), maxFlights, airline);
+        for (int h = 1; h <= maxFlights; h++)
+            for (size_t j = 0; j < dest.size(); j++) {
+                if (s == dest[j]) continue;
+                double distance = distances[h][targets[j]];
+                if (distance == SearchContext::INF) continue;
+                auto &[best, pairs] = res[h - 1];
+                if (distance < best) {
+                    best = distance;
+                    pairs.clear();
+                    pairs.emplace_back(s, dest[j]);
+                }
+                else if (distance == best)
+                    pairs.emplace_back(s, dest[j]);
+            }
+    }
     return res;
 }
 
 
 void Utils::countAirportsPerCountry() {
     map<string, int> airportsPerCountry;
-    for (const auto& i : airportsPerCity){
+    for (const auto& i : data->airportsPerCity){
         if (airportsPerCountry.find(i.first.first) == airportsPerCountry.end())
             airportsPerCountry[i.first.first] = i.second.size();
         else{
@@ -116,10 +259,10 @@ void Utils::countAirportsPerCountry() {
 
 int Utils::countAirlinesPerCountry(const string& country) {
     int count = 0;
-    for (auto airline : airlines)
+    for (auto airline : data->airlines)
         if (airline.getCountry() == country)
             count++;
     return count;
 }
 
-map<string,int> Utils::getNrAirportsPerCountry() const {return nrAirportsPerCountry;}
+map<string,int> const& Utils::getNrAirportsPerCountry() const {return nrAirportsPerCountry;}
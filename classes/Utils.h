@@ -14,8 +14,11 @@ private:
 
 public:
 
-    Utils();
-    map<string,int> getNrAirportsPerCountry() const;
+    /**
+     * @param parallel - load flights.csv with Parser::createGraph
+     */
+    explicit Utils(bool parallel = false);
+    map<string,int> const& getNrAirportsPerCountry() const;
 
     /**
      * Verifies if a country is in the countries unordered_set\n\n
@@ -73,14 +76,12 @@ public:
      */
     bool isValidCity(const string& country, const string& city);
 
-    vector<string> localAirports(double, double, double) const;
-
 
     /**
      * Calculates the total number of flights\n\n
      * <b>Complexity\n</b>
      * <pre>
-     *      <b>O(|V|)</b>, V -> number of nodes
+     *      <b>O(1)</b>
      * </pre>
      * @return number of flights
      */
@@ -97,20 +98,121 @@ public:
      * @param radius - radius of the circumference
      * @return vector of codes of airports that exist in that range
      */
-    list<pair<string,string>> processFlight(int&, const vector<string>&, const vector<string>&, const Airline::AirlineH&);
+    vector<string> localAirports(double, double, double) const;
+
+    /**
+     * Gets the vertex id of every airport code\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(n)</b>, n -> number of codes
+     * </pre>
+     * @param codes - airport codes
+     * @return vertex ids, in the same order
+     */
+    vector<int> airportIds(const vector<string>& codes) const;
+
+    /**
+     * Checks if an airport code is in both vectors\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(n+m)</b> average, n -> size of src, m -> size of dest
+     * </pre>
+     */
+    static bool overlap(const vector<string>& src, const vector<string>& dest);
+
+    /**
+     * Turns (source node, target node) pairs into airport code pairs, ordered by position in src and then in dest\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(n+m+p*log(p))</b>, n -> size of src, m -> size of dest, p -> number of pairs
+     * </pre>
+     */
+    list<pair<string,string>> toCodes(const vector<pair<int,int>>& pairs, const vector<string>& src,
+                                      const vector<string>& dest) const;
+
+    /**
+     * Finds the (source, target) airport pairs joined by the fewest flights, with one Graph::nearestFlights bfs
+     * seeded with every source (one Graph::flightsMatrix bfs per source when an airport is on both sides)\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O((|V|+|E|)*n)</b>,n -> size of src vector, V -> number of nodes, E -> number of edges
+     * </pre>
+     * @param bestFlight - set to the smallest number of flights
+     * @param src - source airport codes
+     * @param dest - target airport codes
+     * @param airline - mask of the airlines available for use
+     * @return list of all best possible pairs
+     */
+    list<pair<string,string>> processFlight(int&, const vector<string>&, const vector<string>&, const AirlineMask&);
+
+    /**
+     * Finds the (source, target) airport pairs with the smallest flown distance, with one Graph::nearestDistance
+     * search from every source at once (one Graph::distanceMatrix when an airport is on both sides)\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|E|log(|V|))</b>, V -> number of nodes, E -> number of edges
+     * </pre>
+     * @param bestDistance - set to the smallest distance
+     * @param src  - source airport codes
+     * @param dest - target airport codes
+     * @param airline - mask of the airlines available for use
+     * @return list of all best possible pairs
+     */
+    list<pair<string,string>> processDistance(double&, const vector<string>&, const vector<string>&, const AirlineMask&);
+
+    /**
+     * Finds the route with the fewest airline changes (and then the smallest flown distance) from a source airport to
+     * a target airport, with one Graph::fewestAirlineChanges search from every source at once (one per source when an
+     * airport is on both sides)\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O((S+|E|)log(S))</b>, S -> number of (airport, airline) states, E -> number of edges
+     * </pre>
+     * @param distance - set to the flown distance of the route
+     * @param path - set to the airports of the route
+     * @param legs - set to the airline of each flight of the route
+     * @param src  - source airport codes
+     * @param dest - target airport codes
+     * @param airline - mask of the airlines available for use
+     * @return the number of airline changes (INT_MAX if there is no route)
+     */
+    int processChanges(double& distance, vector<int>& path, vector<Airline::Id>& legs, const vector<string>& src,
+                       const vector<string>& dest, const AirlineMask& airline);
+
+    /**
+     * Finds every route from a source airport to a target airport that is not beaten in both number of flights and
+     * flown distance by another one, with one Graph::paretoRoutes search from every source at once (one per source
+     * when an airport is on both sides, keeping the routes no other source beats)\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(H*|E|)</b>, H -> flights of the shortest route by distance, E -> number of edges
+     * </pre>
+     * @param paths - set to the route of each point
+     * @param src  - source airport codes
+     * @param dest - target airport codes
+     * @param airline - mask of the airlines available for use
+     * @return the points (flights, distance), by increasing flights and decreasing distance (empty if there is no route)
+     */
+    vector<pair<int, double>> processPareto(vector<vector<int>>& paths, const vector<string>& src,
+                                            const vector<string>& dest, const AirlineMask& airline);
 
     /**
-     * Calculates the smallest amount of flights possible to get to a specific airport from another airport\n\n
+     * Finds, for every budget h from 1 to maxFlights, the (source, target) airport pairs with the smallest flown
+     * distance using at most h flights, with one Graph::hopLimitedDistances call per source (which answers every
+     * budget at once)\n\n
      * <b>Complexity\n</b>
      * <pre>
-     *      <b>O(n*m*(|V|+|E|))</b>,n -> size of src vector, m -> size of dest vector,V -> number of nodes, E -> number of edges
+     *      <b>O(|S|*K*(|V|+|E|))</b>, S -> source airports, K -> maxFlights, V -> number of nodes, E -> number of edges
      * </pre>
-     * @param src  - source node
-     * @param dest - final node
-     * @param airline - airlines available for use (if empty, use all airlines)
-     * @return list of all best possible paths
+     * @param maxFlights - largest budget K
+     * @param src  - source airport codes
+     * @param dest - target airport codes
+     * @param airline - mask of the airlines available for use
+     * @return res[h-1] = (smallest distance with at most h flights, its pairs), SearchContext::INF and no pairs if none
      */
-    list<pair<string,string>> processDistance(double&, const vector<string>&, const vector<string>&, const Airline::AirlineH&);
+    vector<pair<double, list<pair<string,string>>>> processHopLimited(int maxFlights, const vector<string>& src,
+                                                                      const vector<string>& dest,
+                                                                      const AirlineMask& airline);
 
     /**
      * Calculates the number of airports that belong to each country\n\n
@@ -1,5 +1,7 @@
 #include "airline.h"
 
+Interner<Airline::Id> Airline::codes;
+
 Airline::Airline(string code, string name, string callSign, string country){
     this->code = std::move(code);
     this->name = std::move(name);
@@ -12,8 +14,28 @@ Airline::Airline(string code){
 }
 
 string Airline::getCode() const {return this->code;}
-string Airline::getName(){return this->name;}
-string Airline::getCountry(){return this->country;}
+string Airline::getName() const {return this->name;}
+string Airline::getCallSign() const {return this->callSign;}
+string Airline::getCountry() const {return this->country;}
 
+Airline::Id Airline::intern(string_view code) {return codes.intern(code);}
+Airline::Id Airline::idOf(string_view code) {return codes.find(code);}
+const string &Airline::codeOf(Id id) {return codes.getCode(id);}
+int Airline::nrIds() {return codes.size();}
 
+AirlineMask::AirlineMask() = default;
 
+AirlineMask::AirlineMask(const Airline::IdH &airlines) {
+    if (airlines.empty()) return;
+    nrBits = Airline::nrIds();
+    words.assign((nrBits + 63) / 64, 0);
+    size_t selected = 0;
+    for (Airline::Id id : airlines) {
+        if (id >= nrBits) continue;
+        words[id >> 6] |= uint64_t(1) << (id & 63);
+        selected++;
+    }
+    // selecting every interned airline is the same as no selection
+    all = selected == nrBits;
+    if (all) words.clear();
+}
@@ -2,11 +2,15 @@
 #define AIRBUSMANAGEMENTSYSTEM_AIRLINE_H
 #include <iostream>
 #include <unordered_set>
+#include <vector>
+#include <cstdint>
+#include "Interner.h"
 using namespace std;
 
 /**
  * @file
- * @brief Contains the Airline class that represents airline information and its hash structure.
+ * @brief Contains the Airline class that represents airline information and its hash structure,
+ * @brief and the AirlineMask used to filter flights by airline.
  */
 
 /**
@@ -15,6 +19,11 @@ using namespace std;
  */
 class Airline {
 public:
+    /**
+     * @brief Dense id of an interned airline code.
+     */
+    typedef uint16_t Id;
+
     /**
      * @brief Constructor for Airline class that takes only the airline code.
      * @param code The airline code.
@@ -70,24 +79,109 @@ public:
      * @brief Gets the name of the airline.
      * @return The name of the airline.
      */
-    string getName();
+    [[nodiscard]] string getName() const;
+
+    /**
+     * @brief Gets the call sign of the airline.
+     * @return The call sign of the airline.
+     */
+    [[nodiscard]] string getCallSign() const;
 
     /**
      * @brief Gets the country of the airline.
      * @return The country of the airline.
      */
-    string getCountry();
+    [[nodiscard]] string getCountry() const;
 
     /**
      * @brief Defines an unordered set of Airline objects using the custom hash and equality function.
      */
     typedef unordered_set<Airline, Airline::AirlineHash, Airline::AirlineHash> AirlineH;
 
+    /**
+     * @brief Defines an unordered set of interned airline ids.
+     */
+    typedef unordered_set<Id> IdH;
+
+    /**
+     * @brief Id returned by idOf when the code was never interned.
+     */
+    static constexpr Id NOT_FOUND = Interner<Id>::NOT_FOUND;
+
+    /**
+     * @brief Interns an airline code into the global airline table.
+     * @param code The airline code.
+     * @return The dense id of the code (a new one if the code was not interned yet).
+     */
+    static Id intern(string_view code);
+
+    /**
+     * @brief Searches the id of an airline code in the global airline table.
+     * @param code The airline code.
+     * @return The id of the code, or NOT_FOUND.
+     */
+    static Id idOf(string_view code);
+
+    /**
+     * @brief Resolves an interned airline id back into its code.
+     * @param id The airline id.
+     * @return The airline code.
+     */
+    static const string &codeOf(Id id);
+
+    /**
+     * @brief Gets the number of interned airlines.
+     * @return The number of interned airlines, every id is smaller than this value.
+     */
+    static int nrIds();
+
 private:
+    static Interner<Id> codes; /**< Global table of interned airline codes. */
+
     string code;     /**< The airline code. */
     string name;     /**< The name of the airline. */
     string callSign; /**< The call sign of the airline. */
     string country;  /**< The country of the airline. */
 };
 
+/**
+ * @class AirlineMask
+ * @brief Precompiled airline filter: a bitset over the interned airline ids.
+ * @details It is built once from the user's selection and passed by reference to the graph algorithms,
+ * @details so checking if a flight may be used is a single bit test. The bitset is sized from Airline::nrIds()
+ * @details when the mask is built, so there is no limit on the number of airlines of airlines.csv.
+ */
+class AirlineMask {
+public:
+    /**
+     * @brief Constructor for a mask that accepts every airline.
+     */
+    AirlineMask();
+
+    /**
+     * @brief Constructor for a mask that accepts only the selected airlines.
+     * @param airlines The ids of the selected airlines (if empty, every airline is accepted).
+     */
+    explicit AirlineMask(const Airline::IdH &airlines);
+
+    /**
+     * @brief Checks if the flights of an airline may be used.
+     * @param id The interned airline id (an id interned after the mask was built is not accepted by a selection).
+     * @return True if the airline is accepted by the mask, otherwise false.
+     */
+    [[nodiscard]] bool allows(Airline::Id id) const {
+        return all || (id < nrBits && (words[id >> 6] >> (id & 63) & 1));
+    }
+
+    /**
+     * @brief Checks if the mask accepts every airline, i.e. does not filter anything.
+     */
+    [[nodiscard]] bool allowsAll() const {return all;}
+
+private:
+    vector<uint64_t> words; /**< Bit i is set if the airline with id i is accepted. */
+    size_t nrBits = 0;      /**< Number of bits of words, Airline::nrIds() when the mask was built. */
+    bool all = true;        /**< Set if every airline is accepted, words is then empty. */
+};
+
 #endif //AIRBUSMANAGEMENTSYSTEM_AIRLINE_H
@@ -111,8 +111,8 @@ void Menu::chooseSource() {
             string city = validateCity(country);
             if (city == "0") continue;
 
-            auto airportsPerCity = utilities->getCity();
-            src = airportsPerCity[{country,city}];
+            const auto &airportsPerCity = utilities->getCity();
+            src = airportsPerCity.at({country,city});
 
             chooseTarget();
             return;
@@ -172,8 +172,8 @@ void Menu::chooseTarget() {
             string city = validateCity(country);
             if (city == "0") continue;
 
-            auto airportsPerCity = utilities->getCity();
-            dest = airportsPerCity[{country,city}];
+            const auto &airportsPerCity = utilities->getCity();
+            dest = airportsPerCity.at({country,city});
 
             chooseAirlines(true);
             return;
@@ -217,14 +217,14 @@ void Menu::chooseAirlines(bool op) {
     if (choice == "1") {
         string airline = validateAirline();
         if (airline == "0") { chooseTarget(); return; }
-        airlines.insert(Airline(airline));
+        airlines.insert(Airline::idOf(airline));
 
         string option = validateOption("\n Deseja inserir mais alguma companhia aérea? \n\n"
                                        " [1] Sim\n [2] Não\n\n Opção: ");
         while (option == "1") {
             airline = validateAirline();
             if (airline == "0") { chooseTarget(); return; }
-            airlines.insert(Airline(airline));
+            airlines.insert(Airline::idOf(airline));
             option = validateOption("\n Deseja inserir mais alguma companhia aérea? \n\n"
                                     " [1] Sim\n [2] Não\n\n Opção: ");
         }
@@ -238,30 +238,85 @@ void Menu::chooseAirlines(bool op) {
  * @brief Where the result might be different.\n\n
  */
 void Menu::processOperation() {
-    Graph graph = utilities->getGraph();
-    auto map = utilities->getMap();
+    const auto &map = utilities->getMap();
     string option = validateOption("\n Indique o critério a usar: \n\n"
-                                   " [1] Número mínimo de voos\n [2] Distância mínima percorrida\n\n Opção: ");
+                                   " [1] Número mínimo de voos\n [2] Distância mínima percorrida\n"
+                                   " [3] Número mínimo de mudanças de companhia aérea\n"
+                                   " [4] Compromissos entre número de voos e distância\n"
+                                   " [5] Distância mínima com um número máximo de voos\n\n Opção: ", 5);
     if (option == "0") {
         chooseAirlines(true);
         return;
     }
 
+    AirlineMask mask(airlines);
+
     if (option == "1"){
         printf(BOLD FG_GREEN"\n===============================================================\n" RESET_COLOR);
         int nrPath = 0, nrFlights;
-        auto flightPath = utilities->processFlight(nrFlights,src,dest,airlines);
+        uint64_t total = 0;
+        auto flightPath = utilities->processFlight(nrFlights,src,dest,mask);
         if (nrFlights == INT_MAX) cout << " Não existem voos \n\n";
         else{
             for (const auto& pair : flightPath) {
                 string source = pair.first;
                 string target = pair.second;
-                utilities->getGraph().printPathsByFlights(nrPath,map[source], map[target],airlines);
+                uint64_t paths = utilities->getGraph().printPathsByFlights(context,nrPath,map.at(source), map.at(target),mask,PATHS_SHOWN);
+                total = paths > ShortestPathDag::MANY - total ? ShortestPathDag::MANY : total + paths;
             }
-            if (nrPath != 1) cout << " No total, existem " << nrPath << " trajetos possíveis\n\n";
-            else cout << " Apenas existe 1 trajeto possível\n\n";
+            if (total == ShortestPathDag::MANY) cout << " No total, existem mais de " << total << " trajetos possíveis";
+            else if (total != 1) cout << " No total, existem " << total << " trajetos possíveis";
+            else cout << " Apenas existe 1 trajeto possível";
+            if (total > (uint64_t)nrPath) cout << " (mostrados os primeiros " << nrPath << ")";
+            cout << "\n\n";
             cout << " O número mínimo de voos é " << nrFlights << "\n\n";}
     }
+    else if (option == "3"){
+        printf(BOLD FG_GREEN"\n===============================================================\n" RESET_COLOR);
+        double distance;
+        vector<int> path;
+        vector<Airline::Id> legs;
+        int changes = utilities->processChanges(distance,path,legs,src,dest,mask);
+        if (changes == INT_MAX) cout << " Não existem voos \n\n";
+        else{
+            cout << " Trajeto: ";
+            utilities->getGraph().printRoute(path,legs);
+            cout << " O número mínimo de mudanças de companhia aérea é " << changes << " (" << distance << " km)\n\n";
+        }
+    }
+    else if (option == "4"){
+        printf(BOLD FG_GREEN"\n===============================================================\n" RESET_COLOR);
+        vector<vector<int>> paths;
+        auto frontier = utilities->processPareto(paths,src,dest,mask);
+        if (frontier.empty()) cout << " Não existem voos \n\n";
+        for (size_t i = 0; i < frontier.size(); i++) {
+            cout << " Com " << frontier[i].first << (frontier[i].first == 1 ? " voo" : " voos")
+                 << " (" << frontier[i].second << " km): ";
+            utilities->getGraph().printPath(paths[i],mask);
+        }
+    }
+    else if (option == "5"){
+        int maxFlights = customTop("\n Indique o número máximo de voos (1 a " + to_string(MAX_FLIGHTS_BUDGET) + "): ",
+                                   MAX_FLIGHTS_BUDGET, 1);
+        printf(BOLD FG_GREEN"\n===============================================================\n" RESET_COLOR);
+        auto budgets = utilities->processHopLimited(maxFlights,src,dest,mask);
+        for (int h = 1; h <= maxFlights; h++) {
+            const auto &[distance, pairs] = budgets[h - 1];
+            cout << " Com até " << h << (h == 1 ? " voo: " : " voos: ");
+            if (pairs.empty()) {
+                cout << "não existem voos\n";
+                continue;
+            }
+            cout << distance << " km (";
+            bool first = true;
+            for (const auto &[source, target] : pairs) {
+                cout << (first ? "" : ", ") << source << " -> " << target;
+                first = false;
+            }
+            cout << ")\n";
+        }
+        cout << "\n";
+    }
     else{
         printf(BOLD FG_GREEN"\n===============================================================\n" RESET_COLOR);
         int nrPath = 0;
@@ -269,12 +324,12 @@ void Menu::processOperation() {
 
 
         auto start = std::chrono::steady_clock::now();
-        auto flightPath = utilities->processDistance(distance,src,dest,airlines);
+        auto flightPath = utilities->processDistance(distance,src,dest,mask);
 
         for (const auto& pair : flightPath) {
             string source = pair.first;
             string target = pair.second;
-            utilities->getGraph().printPathsByDistance(nrPath,map[source], map[target],airlines);
+            utilities->getGraph().printPathsByDistance(context,backward,nrPath,map.at(source), map.at(target),mask);
         }
 
         auto end = std::chrono::steady_clock::now();
@@ -285,7 +340,15 @@ void Menu::processOperation() {
         // Output the duration
         std::cout << "CreateGraph execution time: " << duration.count() << " milliseconds" << std::endl;
 
-        if (nrPath != 0) cout << " A distância mínima é " << distance << " km\n\n";
+        if (nrPath != 0) {
+            cout << " A distância mínima é " << distance << " km\n\n";
+            int k = customTop(" Quantos trajetos alternativos deseja ver? (0 a " + to_string(MAX_ALTERNATIVES) + "): ",
+                              MAX_ALTERNATIVES);
+            if (k > 0) {
+                for (const auto& pair : flightPath)
+                    utilities->getGraph().printAlternativePaths(context, map.at(pair.first), map.at(pair.second), k, mask);
+            }
+        }
     }
 
     printf(BOLD FG_CYAN"===============================================================\n" RESET_COLOR);
@@ -316,7 +379,7 @@ void Menu::info(){
 
         else if (option == "5"){
             chooseAirlines(false);
-            auto res = utilities->getGraph().articulationPoints(airlines);
+            auto res = utilities->getGraph().articulationPoints(AirlineMask(airlines));
             cout << '\n';
             for(auto index: res){
                 auto airport=utilities->getGraph().getVertexSet()[index]->getAirport();
@@ -388,28 +451,28 @@ void Menu::showAirport(){
         if (option == "1"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = utilities->getMap()[airport];
+            source = utilities->getMap().at(airport);
             cout << "\n";
-            auto edges = utilities->getGraph().getVertexSet()[source]->getAdj();
-            for (const auto& i: edges){
-                string target = utilities->getGraph().getVertexSet()[i.getDest()->getId()]->getAirport().getCode();
-                cout << " " << airport << " ---( "<< i.getAirline().getCode() << " )--- " <<  target << endl;
+            const Graph &graph = utilities->getGraph();
+            for (int e = graph.edgesBegin(source); e < graph.edgesEnd(source); e++){
+                string target = graph.getVertexSet()[graph.getEdgeDest(e)]->getAirport().getCode();
+                cout << " " << airport << " ---( "<< Airline::codeOf(graph.getEdgeAirline(e)) << " )--- " <<  target << endl;
             }
         }
         else if (option == "2"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = utilities->getMap()[airport];
+            source = utilities->getMap().at(airport);
             cout << "\n";
             for (const auto& i: utilities->getGraph().airlinesFromAirport(source)){
                 printf(BOLD FG_MAGENTA" -" RESET_COLOR);
-                cout << " " << i << endl;
+                cout << " " << Airline::codeOf(i) << endl;
             }
         }
         else if (option == "3"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = utilities->getMap()[airport];
+            source = utilities->getMap().at(airport);
             cout << "\n Aeroportos distintos alcancáveis a partir de " << airport << ":\n\n";
             auto airports=utilities->getGraph().airportsFromAirport(source);
             for(const auto& a: airports){
@@ -420,7 +483,7 @@ void Menu::showAirport(){
         else if (option == "4"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = utilities->getMap()[airport];
+            source = utilities->getMap().at(airport);
             cout << "\n";
             for (const auto& i: utilities->getGraph().targetsFromAirport(source)){
                 printf(BOLD FG_CYAN" %s " RESET_COLOR, i.second.c_str()) ;
@@ -430,7 +493,7 @@ void Menu::showAirport(){
         else if (option == "5"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = utilities->getMap()[airport];
+            source = utilities->getMap().at(airport);
             cout << "\n";
             for (const auto& i: utilities->getGraph().countriesFromAirport(source)){
                 printf(BOLD FG_GREEN" -" RESET_COLOR);
@@ -469,7 +532,7 @@ void Menu::showOptions(const string& airport) {
 
         if (option == "1") {
             Airport::AirportH airports = utilities->getGraph().listReachableEntities<Airport::AirportH>
-                    (utilities->getMap()[airport],  maxFlight);
+                    (context, utilities->getMap().at(airport),  maxFlight);
             cout << "\n A partir de " << airport << " é possível alcançar o(s) seguinte(s) aeroporto(s)" << "\n\n";
             for(const auto& airport_ : airports){
                 printf(BOLD FG_GREEN" %s " RESET_COLOR, airport_.getCode().c_str());
@@ -480,7 +543,7 @@ void Menu::showOptions(const string& airport) {
         }
         else if (option == "2") {
             Airport::CityH2 cities = utilities->getGraph().listReachableEntities<Airport::CityH2>
-                    (utilities->getMap()[airport], maxFlight);
+                    (context, utilities->getMap().at(airport), maxFlight);
 
             cout << "\n A partir de " << airport << " é possível alcançar a(s) seguinte(s) cidades(s)" << "\n\n";
             for(const auto& city : cities){
@@ -492,7 +555,7 @@ void Menu::showOptions(const string& airport) {
         }
         else if (option == "3"){
             std::set<std::string> countries = utilities->getGraph().listReachableEntities<std::set<std::string>>
-                    (utilities->getMap()[airport], maxFlight);
+                    (context, utilities->getMap().at(airport), maxFlight);
 
             cout << "\n A partir de " << airport << " é possível alcançar o(s) seguinte(s) países(s)" << "\n\n";
             for(const auto& country : countries){
@@ -540,32 +603,32 @@ void Menu::showAirports(){
                 }
         }
         else if (option == "3"){
-            Graph graph = utilities->getGraph();
+            const Graph &graph = utilities->getGraph();
             int choice = showTop(), top;
             if (choice == 1) top = 10;
             else if (choice == 2) top = 20;
             else if (choice == 3) top = customTop("\n Selecione um valor para o top: ", 3020);
             else continue;
             int j = 1;
-            for (int i = 0; i < top; i++){
+            for (const auto &airport : graph.topFlightsPerAirport(top)){
                 printf(BOLD FG_CYAN"\n %i" RESET_COLOR, j);
-                cout << ". " << graph.flightsPerAirport()[i].second
-                     << " - " << graph.flightsPerAirport()[i].first << " voos\n";
+                cout << ". " << airport.second
+                     << " - " << airport.first << " voos\n";
                 j++;
             }
         }
         else if (option == "4"){
-            Graph graph = utilities->getGraph();
+            const Graph &graph = utilities->getGraph();
             int choice = showTop(), top;
             if (choice == 1) top = 10;
             else if (choice == 2) top = 20;
             else if (choice == 3) top = customTop("\n Selecione um valor para o top: ",3020);
             else continue;
             int j = 1;
-            for (int i = 0; i < top; i++){
+            for (const auto &airport : graph.topAirlinesPerAirport(top)){
                 printf(BOLD FG_GREEN"\n %i" RESET_COLOR, j);
-                cout<< ". " << graph.airlinesPerAirport()[i].second
-                    << " - " << graph.airlinesPerAirport()[i].first << " companhias aéreas\n";
+                cout<< ". " << airport.second
+                    << " - " << airport.first << " companhias aéreas\n";
                 j++;
             }
         }
@@ -688,7 +751,7 @@ void Menu::statistics() {
 
         else if (option == "5"){
             chooseAirlines(false);
-            auto res = utilities->getGraph().articulationPoints(airlines);
+            auto res = utilities->getGraph().articulationPoints(AirlineMask(airlines));
             cout << "\n Existem" ;
             printf(BOLD FG_CYAN" %lu " RESET_COLOR, res.size()) ;
             cout << "pontos de articulação\n";
@@ -727,7 +790,7 @@ void Menu::numberFlights(){
             string airline = validateAirline();
             if (airline == "0") continue;
             cout << "\n A " << airline << " tem ";
-            printf(BOLD FG_MAGENTA"%d " RESET_COLOR, utilities->getGraph().airlineFlights(airline));
+            printf(BOLD FG_MAGENTA"%d " RESET_COLOR, utilities->getGraph().airlineFlights(Airline::idOf(airline)));
             cout << "voos\n";
         }
         else if (option == "0")
@@ -757,7 +820,7 @@ void Menu::numberAirports() {
         else if (option == "2"){
             string country = validateCountry();
             if (country == "0") continue;
-            int count = utilities->getNrAirportsPerCountry()[country];
+            int count = utilities->getNrAirportsPerCountry().at(country);
 
             cout << "\n Neste país (" << country << ") existem ";
             printf(BOLD FG_RED"%i" RESET_COLOR, count);
@@ -823,23 +886,23 @@ void Menu::airportStats() {
         if (option == "1"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = utilities->getMap()[airport];
+            source = utilities->getMap().at(airport);
             cout << "\n Nº de voos existentes a partir de " << airport << ":";
-            printf(BOLD FG_CYAN" %lu \n" RESET_COLOR, utilities->getGraph().getVertexSet()[source]->getAdj().size()) ;
+            printf(BOLD FG_CYAN" %d \n" RESET_COLOR, utilities->getGraph().getOutDegree(source)) ;
         }
 
         else if (option == "2"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = utilities->getMap()[airport];
+            source = utilities->getMap().at(airport);
             cout << "\n Nº de companhias aéreas de " << airport << ":";
-            printf(BOLD FG_CYAN" %lu \n" RESET_COLOR, utilities->getGraph().airlinesFromAirport(source).size());
+            printf(BOLD FG_CYAN" %d \n" RESET_COLOR, utilities->getGraph().getNrAirlines(source));
         }
 
         else if (option == "3"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = utilities->getMap()[airport];
+            source = utilities->getMap().at(airport);
             cout << "\n Nº de destinos distintos alcancáveis a partir de " << airport << ":";
             printf(BOLD FG_CYAN" %lu \n" RESET_COLOR, utilities->getGraph().targetsFromAirport(source).size());
         }
@@ -847,14 +910,14 @@ void Menu::airportStats() {
         else if (option == "4"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = utilities->getMap()[airport];
+            source = utilities->getMap().at(airport);
             cout << "\n Nº de aeroportos distintos alcancáveis a partir de " << airport << ":";
             printf(BOLD FG_CYAN" %lu \n" RESET_COLOR, utilities->getGraph().airportsFromAirport(source).size());
         }
         else if (option == "5"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = utilities->getMap()[airport];
+            source = utilities->getMap().at(airport);
             cout << "\n Nº de países diferentes alcancáveis a partir de " << airport << ":";
             printf(BOLD FG_CYAN" %lu \n" RESET_COLOR, utilities->getGraph().countriesFromAirport(source).size());
         }
@@ -883,7 +946,7 @@ void Menu::maxReach() {
 
         if (option == "1") {
             auto airports = utilities->getGraph().listReachableEntities<Airport::AirportH>
-                    (utilities->getMap()[airport],  maxFlight);
+                    (context, utilities->getMap().at(airport),  maxFlight);
             cout << "\n A partir de " << airport << " é possível alcançar o(s) seguinte(s) aeroporto(s)" << "\n\n";
             for(const auto& airport_ : airports){
                 printf(BOLD FG_GREEN" %s " RESET_COLOR, airport_.getCode().c_str());
@@ -894,7 +957,7 @@ void Menu::maxReach() {
         }
         else if (option == "2") {
             auto cities = utilities->getGraph().listReachableEntities<Airport::CityH2>
-                    (utilities->getMap()[airport], maxFlight);
+                    (context, utilities->getMap().at(airport), maxFlight);
 
             cout << "\n A partir de " << airport << " é possível alcançar a(s) seguinte(s) cidades(s)" << "\n\n";
             for(const auto& city : cities){
@@ -906,7 +969,7 @@ void Menu::maxReach() {
         }
         else if (option == "3"){
             auto countries = utilities->getGraph().listReachableEntities<std::set<std::string>>
-                    (utilities->getMap()[airport], maxFlight);
+                    (context, utilities->getMap().at(airport), maxFlight);
 
             cout << "\n A partir de " << airport << " é possível alcançar o(s) seguinte(s) países(s)" << "\n\n";
             for(const auto& country : countries){
@@ -949,13 +1012,14 @@ int Menu::showTop(){
  * @brief User can decide the size of the top he wants to see.\n\n
  * @param message - message chosen from developers
  * @param n - maximum range for top
+ * @param min - minimum accepted value
  * @return top size
  */
-int Menu::customTop(const string& message, int n) {
+int Menu::customTop(const string& message, int n, int min) {
     cout << message;
     int option; cin >> option;
-    while (cin.fail() || option < 0 || option > n){
-        cout << " Escolha um número entre 1 e " << n << "\n Tente novamente: ";
+    while (cin.fail() || option < min || option > n){
+        cout << " Escolha um número entre " << max(min, 1) << " e " << n << "\n Tente novamente: ";
         cin.clear();
         cin.ignore(INT_MAX, '\n');
         cin >> option;
@@ -991,7 +1055,7 @@ string Menu::validateAirline() {
     string airline;
     cout << " Insira o código ICAO da companhia aérea (ex: IBE): "; cin >> airline;
 
-    while(cin.fail() || !utilities->isAirline(Airline(airline)) || airlines.find(Airline(airline)) != airlines.end()) {
+    while(cin.fail() || !utilities->isAirline(Airline(airline)) || airlines.find(Airline::idOf(airline)) != airlines.end()) {
         if (airline == "0") return "0";
         if (cin.fail() || airline.size() != 3) cout << " Input inválido " << '\n';
         else if (!utilities->isAirline(Airline(airline))) cout << " Não existe nenhuma companhia aérea com este código " << '\n';
@@ -1123,12 +1187,13 @@ vector<string> Menu::validateLocal() {
 /**
  * @brief Verifies if the option selected by the user is valid or not
  * @param message - message chosen from developers
+ * @param options - highest valid option (0 is always valid)
  * @return user's option
  */
-string Menu::validateOption(const string &message) {
+string Menu::validateOption(const string &message, int options) {
     string option;
     cout << message; cin >> option;
-    while(!(option == "0" || option == "1" || option == "2")) {
+    while(!(option.size() == 1 && option[0] >= '0' && option[0] <= '0' + options)) {
         cout << "\n Input inválido" << '\n';
         cout << message;
         cin.clear();
@@ -13,6 +13,10 @@ public:
     void init();
     static void end();
 private:
+    static constexpr int PATHS_SHOWN = 20; ///< Routes with the fewest flights printed per query, the rest only counted.
+    static constexpr int MAX_ALTERNATIVES = 10; ///< Most alternative routes by distance that can be asked for.
+    static constexpr int MAX_FLIGHTS_BUDGET = 10; ///< Largest number of flights of the hop-limited distances.
+
     void chooseSource();
     void chooseTarget();
     void chooseAirlines(bool op);
@@ -33,7 +37,7 @@ private:
     void maxReach();
 
     static int showTop();
-    static int customTop(const string& message, int n);
+    static int customTop(const string& message, int n, int min = 0);
 
     string validateAirport();
     string validateAirline();
@@ -43,12 +47,14 @@ private:
     static double validateLongitude();
     static double validateRadius();
     vector<string> validateLocal();
-    static string validateOption(const string& message);
+    static string validateOption(const string& message, int options = 2);
 
     Utils* utilities;
+    SearchContext context;
+    SearchContext backward; ///< Backward side of the bidirectional distance searches.
     vector<string> src;
     vector<string> dest;
-    Airline::AirlineH airlines;
+    Airline::IdH airlines;
 
 };
 
@@ -0,0 +1,442 @@
+#include "contraction_hierarchy.h"
+#include "graph.h"
+#include "../classes/MappedFile.h"
+#include "../classes/Snapshot.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+
+/**
+ * @file
+ * @brief Contains the ContractionHierarchy class implementation
+ */
+
+namespace {
+
+const char MAGIC[8] = {'A', 'B', 'M', 'C', 'H', 'I', 'E', '\0'};
+
+/**
+ * First bytes of a hierarchy file, followed by int rank[n], int upOffsets[n + 1], Arc up[nrUp],
+ * int downOffsets[n + 1] and Arc down[nrDown].
+ */
+struct HierarchyHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t nrVertices;
+    uint64_t sourceChecksum;
+    uint64_t payloadChecksum;
+    uint32_t nrUp;
+    uint32_t nrDown;
+    uint32_t nrShortcuts;
+    uint32_t padding;
+};
+
+/**
+ * Arc of the graph that is being contracted.
+ */
+struct WorkArc {
+    int to;
+    double weight;
+    int middle;
+};
+
+/**
+ * Most vertices a witness search settles before giving up (and letting a shortcut be added): a small limit when
+ * the shortcuts are only counted for the priority, a larger one when they are really added.
+ */
+constexpr int SIMULATION_SETTLE_LIMIT = 20;
+constexpr int CONTRACTION_SETTLE_LIMIT = 500;
+
+/**
+ * Contraction state: the remaining graph, with flights and shortcuts between the vertices not contracted yet.
+ */
+struct Contraction {
+    vector<vector<WorkArc>> out, in;
+    vector<bool> contracted;
+    SearchContext witness;
+
+    explicit Contraction(int n) : out(n), in(n), contracted(n, false), witness(n) {}
+
+    /**
+     * Adds the arc u -> w, or lowers the weight of the one already there.
+     */
+    bool addArc(int u, int w, double weight, int middle) {
+        for (WorkArc &a : out[u]) {
+            if (a.to != w) continue;
+            if (a.weight <= weight) return false;
+            a.weight = weight;
+            a.middle = middle;
+            for (WorkArc &b : in[w])
+                if (b.to == u) {b.weight = weight; b.middle = middle;}
+            return true;
+        }
+        out[u].push_back({w, weight, middle});
+        in[w].push_back({u, weight, middle});
+        return true;
+    }
+
+    /**
+     * Dijkstra from u over the remaining graph without v, until every out-neighbour of v is settled, limit is
+     * passed or too many vertices are settled.
+     * Afterwards witness.getDistance(w) is the length of some path u -> w that avoids v, or INF.
+     */
+    void witnessSearch(int u, int v, double limit, int settleLimit, int n) {
+        witness.reset(n);
+        for (const WorkArc &b : out[v]) witness.setVisited(b.to); // visited marks the targets left
+        int targets = (int)out[v].size() - (witness.isVisited(u) ? 1 : 0);
+
+        witness.setDistance(u, 0, -1);
+        SearchQueue &heap = witness.getHeap();
+        heap.insert(u, 0);
+        int settled = 0;
+        while (!heap.empty() && targets > 0) {
+            if (heap.minValue() > limit || ++settled > settleLimit) break;
+            int x = heap.extractMin();
+            double d = witness.getDistance(x);
+            if (x != u && witness.isVisited(x)) targets--;
+            for (const WorkArc &a : out[x]) {
+                if (a.to == v) continue;
+                double nd = d + a.weight;
+                if (nd <= limit && nd < witness.getDistance(a.to)) {
+                    bool queued = witness.getDistance(a.to) != SearchContext::INF;
+                    witness.setDistance(a.to, nd, x);
+                    if (queued) heap.decreaseKey(a.to, nd);
+                    else heap.insert(a.to, nd);
+                }
+            }
+        }
+    }
+
+    /**
+     * Shortcuts needed to contract v; they are added if add is set, otherwise only counted.
+     */
+    int shortcuts(int v, bool add, int n) {
+        int count = 0;
+        double maxOut = 0;
+        for (const WorkArc &b : out[v]) maxOut = max(maxOut, b.weight);
+
+        for (const WorkArc &a : in[v]) {
+            int u = a.to;
+            witnessSearch(u, v, a.weight + maxOut, add ? CONTRACTION_SETTLE_LIMIT : SIMULATION_SETTLE_LIMIT, n);
+            for (const WorkArc &b : out[v]) {
+                int w = b.to;
+                if (w == u) continue;
+                double via = a.weight + b.weight;
+                if (witness.getDistance(w) <= via) continue; // a path as short that avoids v
+                count++;
+                if (add) addArc(u, w, via, v);
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Removes every arc between v and the remaining graph.
+     */
+    void remove(int v) {
+        contracted[v] = true;
+        auto drop = [v](vector<WorkArc> &arcs) {
+            arcs.erase(remove_if(arcs.begin(), arcs.end(), [v](const WorkArc &a) {return a.to == v;}), arcs.end());
+        };
+        for (const WorkArc &a : in[v]) drop(out[a.to]);
+        for (const WorkArc &b : out[v]) drop(in[b.to]);
+    }
+};
+
+}
+
+ContractionHierarchy::ContractionHierarchy(const Graph &graph) {
+    nrVertices = graph.getNumVertex();
+    int n = nrVertices;
+    Contraction c(n);
+
+    // parallel flights of different airlines collapse into the lightest one, self loops are useless
+    for (int u = 0; u < n; u++)
+        for (int e = graph.edgesBegin(u); e < graph.edgesEnd(u); e++)
+            if (graph.getEdgeDest(e) != u)
+                c.addArc(u, graph.getEdgeDest(e), graph.getEdgeWeight(e), -1);
+
+    vector<int> contractedNeighbours(n, 0);
+    auto priority = [&](int v) {
+        int removed = (int)(c.in[v].size() + c.out[v].size());
+        return c.shortcuts(v, false, n) - removed + contractedNeighbours[v];
+    };
+
+    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<>> order;
+    for (int v = 0; v < n; v++) order.emplace(priority(v), v);
+
+    rank.assign(n, -1);
+    vector<vector<Arc>> upArcs(n), downArcs(n);
+    int next = 0;
+    while (!order.empty()) {
+        auto [p, v] = order.top();
+        order.pop();
+        if (c.contracted[v]) continue;
+
+        // lazy update: the priority may have grown since v was queued
+        int current = priority(v);
+        if (!order.empty() && current > order.top().first) {
+            order.emplace(current, v);
+            continue;
+        }
+
+        nrShortcuts += c.shortcuts(v, true, n);
+        rank[v] = next++;
+        for (const WorkArc &b : c.out[v]) upArcs[v].push_back({b.to, b.middle, b.weight});
+        for (const WorkArc &a : c.in[v]) downArcs[v].push_back({a.to, a.middle, a.weight});
+        for (const WorkArc &a : c.in[v]) contractedNeighbours[a.to]++;
+        for (const WorkArc &b : c.out[v]) contractedNeighbours[b.to]++;
+        c.remove(v);
+    }
+
+    auto flatten = [n](vector<vector<Arc>> &lists, vector<int> &offsets, vector<Arc> &arcs) {
+        offsets.assign(n + 1, 0);
+        for (int v = 0; v < n; v++) offsets[v + 1] = offsets[v] + (int)lists[v].size();
+        arcs.reserve(offsets[n]);
+        for (auto &list : lists) arcs.insert(arcs.end(), list.begin(), list.end());
+    };
+    flatten(upArcs, upOffsets, up);
+    flatten(downArcs, downOffsets, down);
+}
+
+const ContractionHierarchy::Arc &ContractionHierarchy::findArc(int u, int v) const {
+    if (rank[u] < rank[v]) {
+        for (int i = upOffsets[u]; i < upOffsets[u + 1]; i++)
+            if (up[i].to == v) return up[i];
+    }
+    else {
+        for (int i = downOffsets[v]; i < downOffsets[v + 1]; i++)
+            if (down[i].to == u) return down[i];
+    }
+    throw logic_error("arc not in the hierarchy");
+}
+
+void ContractionHierarchy::unpack(int u, int v, vector<int> &path) const {
+    int middle = findArc(u, v).middle;
+    if (middle == -1) {
+        path.push_back(v);
+        return;
+    }
+    unpack(u, middle, path);
+    unpack(middle, v, path);
+}
+
+double ContractionHierarchy::query(SearchContext &forward, SearchContext &backward, int src, int dest) const {
+    if (src < 0 || dest < 0 || src >= nrVertices || dest >= nrVertices)
+        return SearchContext::INF;
+
+    forward.reset(nrVertices);
+    backward.reset(nrVertices);
+    forward.setDistance(src, 0, -1);
+    backward.setDistance(dest, 0, -1);
+
+    SearchQueue &forwardHeap = forward.getHeap();
+    SearchQueue &backwardHeap = backward.getHeap();
+    forwardHeap.insert(src, 0);
+    backwardHeap.insert(dest, 0);
+
+    double best = src == dest ? 0 : SearchContext::INF;
+    int meet = src == dest ? src : -1;
+
+    // both searches only climb, so neither can stop at the first meeting: each one runs until its
+    // smallest queued distance alone reaches the best route found
+    while (true) {
+        bool forwardDone = forwardHeap.empty() || forwardHeap.minValue() >= best;
+        bool backwardDone = backwardHeap.empty() || backwardHeap.minValue() >= best;
+        if (forwardDone && backwardDone) break;
+
+        bool isForward = backwardDone || (!forwardDone && forwardHeap.minValue() <= backwardHeap.minValue());
+        SearchContext &side = isForward ? forward : backward;
+        const SearchContext &other = isForward ? backward : forward;
+        SearchQueue &heap = isForward ? forwardHeap : backwardHeap;
+        const vector<int> &offsets = isForward ? upOffsets : downOffsets;
+        const vector<Arc> &arcs = isForward ? up : down;
+
+        int u = heap.extractMin();
+        side.setVisited(u);
+        if (other.getDistance(u) != SearchContext::INF && side.getDistance(u) + other.getDistance(u) < best) {
+            best = side.getDistance(u) + other.getDistance(u);
+            meet = u;
+        }
+
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            int v = arcs[i].to;
+            double d = side.getDistance(u) + arcs[i].weight;
+            if (side.isVisited(v) || d >= side.getDistance(v)) continue;
+
+            bool queued = side.getDistance(v) != SearchContext::INF;
+            side.setDistance(v, d, u);
+            if (queued) heap.decreaseKey(v, d);
+            else heap.insert(v, d);
+        }
+    }
+
+    if (meet == -1)
+        return SearchContext::INF;
+
+    // route in the hierarchy: src -> ... -> meet upwards, meet -> ... -> dest downwards
+    vector<int> route;
+    for (int x = meet; x != -1; x = forward.getParent(x)) route.push_back(x);
+    std::reverse(route.begin(), route.end());
+    for (int x = backward.getParent(meet); x != -1; x = backward.getParent(x)) route.push_back(x);
+
+    vector<int> path = {src};
+    for (size_t i = 0; i + 1 < route.size(); i++)
+        unpack(route[i], route[i + 1], path);
+
+    // the flights are summed in route order, as dijkstra does, so both give the very same double
+    for (size_t i = 1; i < path.size(); i++)
+        forward.setDistance(path[i], forward.getDistance(path[i - 1]) + findArc(path[i - 1], path[i]).weight, path[i - 1]);
+
+    return forward.getDistance(dest);
+}
+
+vector<int> ContractionHierarchy::upwardSearch(SearchContext &context, int src, bool forward) const {
+    const vector<int> &offsets = forward ? upOffsets : downOffsets;
+    const vector<Arc> &arcs = forward ? up : down;
+    vector<int> settled;
+
+    context.reset(nrVertices);
+    context.setDistance(src, 0, -1);
+    SearchQueue &heap = context.getHeap();
+    heap.insert(src, 0);
+
+    while (!heap.empty()) {
+        int u = heap.extractMin();
+        context.setVisited(u);
+        settled.push_back(u);
+
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            int v = arcs[i].to;
+            double d = context.getDistance(u) + arcs[i].weight;
+            if (context.isVisited(v) || d >= context.getDistance(v)) continue;
+
+            bool queued = context.getDistance(v) != SearchContext::INF;
+            context.setDistance(v, d, u);
+            if (queued) heap.decreaseKey(v, d);
+            else heap.insert(v, d);
+        }
+    }
+    return settled;
+}
+
+vector<vector<double>> ContractionHierarchy::manyToMany(SearchContext &context, const vector<int> &sources,
+                                                        const vector<int> &targets) const {
+    vector<vector<double>> matrix(sources.size(), vector<double>(targets.size(), SearchContext::INF));
+
+    vector<pair<int, pair<int, double>>> reached; // (vertex, (target index, distance to the target))
+    for (int j = 0; j < (int)targets.size(); j++) {
+        if (targets[j] < 0 || targets[j] >= nrVertices) continue;
+        for (int v : upwardSearch(context, targets[j], false))
+            reached.push_back({v, {j, context.getDistance(v)}});
+    }
+    // the bucket of vertex v is entries[bucketOffsets[v]..bucketOffsets[v + 1])
+    vector<int> bucketOffsets(nrVertices + 1, 0);
+    for (const auto &r : reached) bucketOffsets[r.first + 1]++;
+    for (int v = 0; v < nrVertices; v++) bucketOffsets[v + 1] += bucketOffsets[v];
+    vector<pair<int, double>> entries(reached.size());
+    vector<int> next(bucketOffsets.begin(), bucketOffsets.end() - 1);
+    for (const auto &r : reached) entries[next[r.first]++] = r.second;
+
+    for (int i = 0; i < (int)sources.size(); i++) {
+        if (sources[i] < 0 || sources[i] >= nrVertices) continue;
+        for (int u : upwardSearch(context, sources[i], true)) {
+            double du = context.getDistance(u);
+            for (int b = bucketOffsets[u]; b < bucketOffsets[u + 1]; b++) {
+                auto [j, dt] = entries[b];
+                matrix[i][j] = min(matrix[i][j], du + dt);
+            }
+        }
+    }
+    return matrix;
+}
+
+bool ContractionHierarchy::save(const string &path, uint64_t sourceChecksum) const {
+    HierarchyHeader header{};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.nrVertices = nrVertices;
+    header.sourceChecksum = sourceChecksum;
+    header.nrUp = up.size();
+    header.nrDown = down.size();
+    header.nrShortcuts = nrShortcuts;
+
+    // Arc has no padding, so every byte written is initialized
+    static_assert(sizeof(Arc) == 2 * sizeof(int) + sizeof(double));
+    const pair<const char *, size_t> sections[] = {
+        {(const char *)rank.data(), rank.size() * sizeof(int)},
+        {(const char *)upOffsets.data(), upOffsets.size() * sizeof(int)},
+        {(const char *)up.data(), up.size() * sizeof(Arc)},
+        {(const char *)downOffsets.data(), downOffsets.size() * sizeof(int)},
+        {(const char *)down.data(), down.size() * sizeof(Arc)},
+    };
+    uint64_t hash = Snapshot::FNV_OFFSET;
+    for (auto [bytes, size] : sections) hash = Snapshot::fnv1a(bytes, size, hash);
+    header.payloadChecksum = hash;
+
+    string tmp = path + ".tmp";
+    {
+        ofstream out(tmp, ios::binary | ios::trunc);
+        out.write((const char *)&header, sizeof(header));
+        for (auto [bytes, size] : sections) out.write(bytes, (streamsize)size);
+        if (!out) return false;
+    }
+    return rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+bool ContractionHierarchy::load(const string &path, uint64_t sourceChecksum, int nrVertices) {
+    MappedFile file(path);
+    if (!file.isOpen() || file.size() < sizeof(HierarchyHeader)) return false;
+
+    HierarchyHeader header{};
+    memcpy(&header, file.data(), sizeof(header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) return false;
+    if (header.sourceChecksum != sourceChecksum || (int)header.nrVertices != nrVertices) return false;
+
+    size_t n = header.nrVertices;
+    size_t expected = sizeof(header) + (3 * n + 2) * sizeof(int) + ((size_t)header.nrUp + header.nrDown) * sizeof(Arc);
+    if (file.size() != expected) return false;
+    if (Snapshot::fnv1a(file.data() + sizeof(header), file.size() - sizeof(header), Snapshot::FNV_OFFSET)
+        != header.payloadChecksum) return false;
+
+    const char *p = file.data() + sizeof(header);
+    auto read = [&p](auto &v, size_t count) {
+        v.resize(count);
+        memcpy(v.data(), p, count * sizeof(v[0]));
+        p += count * sizeof(v[0]);
+    };
+    vector<int> r, uo, dO;
+    vector<Arc> u, d;
+    read(r, n);
+    read(uo, n + 1);
+    read(u, header.nrUp);
+    read(dO, n + 1);
+    read(d, header.nrDown);
+
+    // a damaged file must not lead the queries out of the arrays
+    auto valid = [n](const vector<int> &offsets, const vector<Arc> &arcs) {
+        if (offsets[0] != 0 || offsets[n] != (int)arcs.size()) return false;
+        for (size_t v = 0; v < n; v++)
+            if (offsets[v] > offsets[v + 1]) return false;
+        for (const Arc &a : arcs)
+            if (a.to < 0 || a.to >= (int)n || a.middle < -1 || a.middle >= (int)n) return false;
+        return true;
+    };
+    for (int x : r)
+        if (x < 0 || x >= (int)n) return false;
+    if (!valid(uo, u) || !valid(dO, d)) return false;
+
+    this->nrVertices = nrVertices;
+    nrShortcuts = (int)header.nrShortcuts;
+    rank = std::move(r);
+    upOffsets = std::move(uo);
+    up = std::move(u);
+    downOffsets = std::move(dO);
+    down = std::move(d);
+    return true;
+}
@@ -0,0 +1,142 @@
+#ifndef AIRBUSMANAGEMENTSYSTEM_CONTRACTION_HIERARCHY_H
+#define AIRBUSMANAGEMENTSYSTEM_CONTRACTION_HIERARCHY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "search_context.h"
+
+using namespace std;
+
+class Graph;
+
+/**
+ * @file
+ * @brief Contains the ContractionHierarchy class, a preprocessed index for fast point-to-point distance queries.
+ */
+
+/**
+ * @class ContractionHierarchy
+ * @brief Contraction hierarchy (CH) over the flights of a Graph, ignoring airlines.
+ *
+ * The airports are contracted one by one, least important first: contracting v removes it and adds a shortcut
+ * u -> w for every path u -> v -> w that is the only shortest way between u and w (checked by a local witness
+ * search). The importance is the edge difference (shortcuts added minus flights removed) plus the number of
+ * neighbours already contracted, updated lazily.\n
+ * A query is a bidirectional Dijkstra that only climbs to more important airports; the two searches meet at the
+ * most important airport of the route, after settling a few dozen vertices instead of thousands.
+ * Shortcuts remember the airport they skip, so the route is unpacked back into real flights.\n
+ * Airline filters remove flights, which the shortcuts do not know about, so filtered queries must use Dijkstra.
+ */
+class ContractionHierarchy {
+public:
+    static constexpr uint32_t VERSION = 1; ///< Bumped whenever the file layout changes.
+
+    /**
+     * @brief Constructor for an empty hierarchy, to be filled by load.
+     */
+    ContractionHierarchy() = default;
+
+    /**
+     * @brief Contracts every vertex of the graph.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|V|*W)</b> in practice, W -> cost of the bounded witness searches of one vertex
+     * </pre>
+     * @param graph Frozen graph.
+     */
+    explicit ContractionHierarchy(const Graph &graph);
+
+    /**
+     * @brief Calculates the minimum flown distance from src to dest.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(U*log(U) + P)</b>, U -> vertices above src and dest in the hierarchy, P -> unpacked path size
+     * </pre>
+     * @param forward - caller-owned search state, holds the unpacked route afterwards (forward.getPath(dest))
+     * @param backward - caller-owned search state of the backward search
+     * @param src - source node
+     * @param dest - target node
+     * @return the distance (SearchContext::INF if unreachable)
+     */
+    double query(SearchContext &forward, SearchContext &backward, int src, int dest) const;
+
+    /**
+     * @brief Calculates the minimum flown distance from every source to every target with buckets: an upward
+     * search from each target leaves (target, distance) in a bucket at every vertex it settles, then an upward
+     * search from each source reads the buckets of the vertices it settles. Every pair meets at the most important
+     * airport of its route, so |S|+|T| small searches replace |S|*|T| queries.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O((|S|+|T|)*U*log(U) + B)</b>, U -> vertices above a source or target, B -> bucket entries read
+     * </pre>
+     * @param context - caller-owned search state
+     * @param sources - source nodes
+     * @param targets - target nodes
+     * @return matrix[i][j] = distance from sources[i] to targets[j] (SearchContext::INF if unreachable)
+     */
+    [[nodiscard]] vector<vector<double>> manyToMany(SearchContext &context, const vector<int> &sources,
+                                                    const vector<int> &targets) const;
+
+    /**
+     * @brief Gets the number of shortcuts added by the contraction.
+     */
+    [[nodiscard]] int getNrShortcuts() const {return nrShortcuts;}
+
+    /**
+     * @brief Writes the hierarchy to a file.
+     * @param path Path of the file.
+     * @param sourceChecksum Checksum of the data files the graph was loaded from (see Snapshot::checksum).
+     * @return true if the file was written.
+     */
+    bool save(const string &path, uint64_t sourceChecksum) const;
+
+    /**
+     * @brief Reads a hierarchy written by save.
+     * @param path Path of the file.
+     * @param sourceChecksum Checksum of the current data files.
+     * @param nrVertices Number of vertices of the current graph.
+     * @return true if the file matched and was loaded, false if the graph must be contracted again.
+     */
+    bool load(const string &path, uint64_t sourceChecksum, int nrVertices);
+
+private:
+    /**
+     * @brief Arc of the hierarchy, a flight or a shortcut.
+     */
+    struct Arc {
+        int to;         // other end
+        int middle;     // vertex skipped by a shortcut, -1 for a flight
+        double weight;  // flown distance
+    };
+
+    int nrVertices = 0;
+    vector<int> rank;        // position of each vertex in the contraction order
+    vector<int> upOffsets;   // arcs v -> w with rank[w] > rank[v] are up[upOffsets[v]..upOffsets[v+1])
+    vector<Arc> up;
+    vector<int> downOffsets; // arcs u -> v with rank[u] > rank[v] are down[downOffsets[v]..downOffsets[v+1]), to = u
+    vector<Arc> down;
+    int nrShortcuts = 0;
+
+    /**
+     * @brief Dijkstra from src over up (forward) or down (backward) arcs only, until the heap is empty.
+     * @return the settled vertices, in order (their distances are in context)
+     */
+    vector<int> upwardSearch(SearchContext &context, int src, bool forward) const;
+
+    /**
+     * @brief Finds the hierarchy arc u -> v, stored at the less important of the two.
+     */
+    [[nodiscard]] const Arc &findArc(int u, int v) const;
+
+    /**
+     * @brief Appends to path the flights hidden by the arc u -> v, as the vertices after u.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(p*d)</b>, p -> number of flights of the arc, d -> degree in the hierarchy
+     * </pre>
+     */
+    void unpack(int u, int v, vector<int> &path) const;
+};
+
+#endif //AIRBUSMANAGEMENTSYSTEM_CONTRACTION_HIERARCHY_H
@@ -11,7 +11,7 @@
  * @brief Contains the Edge class implementation
  */
 
-Edge::Edge(Vertex *d, Airline airline, double w) : dest(d), weight(w), airline(std::move(airline)) {}
+Edge::Edge(Vertex *d, Airline::Id airline, double w) : dest(d), weight(w), airline(airline) {}
 
 Vertex *Edge::getDest() const {
     return dest;
@@ -21,6 +21,6 @@ double Edge::getWeight() const {
     return weight;
 }
 
-Airline Edge::getAirline() const{
+Airline::Id Edge::getAirline() const{
     return airline;
 }
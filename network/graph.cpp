@@ -1,8 +1,10 @@
 #include "graph.h"
+#include "landmarks.h"
+#include "contraction_hierarchy.h"
 
 #include <utility>
 #include <queue>
-#include "../classes/Parser.h"
+#include <barrier>
 
 /**
  * @file
@@ -33,29 +35,13 @@ bool Graph::findVertex(const int &in) const {
     return (in >= 0 && in < size);
 }
 
-bool Vertex::isVisited() const {
-    return visited;
-}
-
-void Vertex::setVisited(bool v) {
-    Vertex::visited = v;
-}
-
-const list<Edge> &Vertex::getAdj() const {
-    return adj;
-}
-
-double Vertex::getDistance() const{
-    return distance;
-}
-
 /*
  * Adds an edge to a graph (this), given the contents of the source and
  * destination vertices and the edge weight (w).
  * Returns true if successful, and false if the source or destination vertex does not exist.
  */
 
-bool Graph::addFlight(const int &src, const int &dest, const Airline &airline, double w) {
+bool Graph::addFlight(const int &src, const int &dest, Airline::Id airline, double w) {
     if (!findVertex(src) || !findVertex(dest))
         return false;
 
@@ -68,6 +54,120 @@ bool Graph::addAirport(const int &src, const Airport &airport) {
     return true;
 }
 
+void Graph::freeze() {
+    auto frozen = make_shared<CSR>();
+
+    size_t nrEdges = 0;
+    for (const auto &v : vertexSet)
+        nrEdges += v->adj.size();
+
+    frozen->offsets.reserve(vertexSet.size() + 1);
+    frozen->dest.reserve(nrEdges);
+    frozen->weight.reserve(nrEdges);
+    frozen->airline.reserve(nrEdges);
+
+    for (const auto &v : vertexSet) {
+        frozen->offsets.push_back((int)frozen->dest.size());
+        for (const Edge &e : v->adj) {
+            frozen->dest.push_back(e.dest->getId());
+            frozen->weight.push_back(e.weight);
+            frozen->airline.push_back(e.airline);
+        }
+        v->adj.clear();
+    }
+    frozen->offsets.push_back((int)frozen->dest.size());
+
+    csr = std::move(frozen);
+    countAirports();
+    buildReverse();
+    buildStates();
+    placeAirports();
+    hierarchy.reset();
+}
+
+void Graph::freeze(CSR frozen) {
+    csr = make_shared<CSR>(std::move(frozen));
+    countAirports();
+    buildReverse();
+    buildStates();
+    placeAirports();
+    hierarchy.reset();
+}
+
+void Graph::freeze(const vector<EdgeList> &parts) {
+    auto frozen = make_shared<CSR>();
+    int n = getNumVertex();
+
+    frozen->offsets.assign(n + 1, 0);
+    for (const EdgeList &part : parts)
+        for (int s : part.source)
+            frozen->offsets[s + 1]++;
+    for (int v = 0; v < n; v++)
+        frozen->offsets[v + 1] += frozen->offsets[v];
+
+    size_t nrEdges = frozen->offsets[n];
+    frozen->dest.resize(nrEdges);
+    frozen->weight.resize(nrEdges);
+    frozen->airline.resize(nrEdges);
+
+    vector<int> next(frozen->offsets.begin(), frozen->offsets.end() - 1);
+    for (const EdgeList &part : parts) {
+        for (size_t i = 0; i < part.size(); i++) {
+            int e = next[part.source[i]]++;
+            frozen->dest[e] = part.dest[i];
+            frozen->weight[e] = part.weight[i];
+            frozen->airline[e] = part.airline[i];
+        }
+    }
+
+    csr = std::move(frozen);
+    countAirports();
+    buildReverse();
+    buildStates();
+    placeAirports();
+    hierarchy.reset();
+}
+
+const CSR &Graph::getCSR() const {
+    return *csr;
+}
+
+void Graph::setHierarchy(shared_ptr<const ContractionHierarchy> contracted) {
+    hierarchy = std::move(contracted);
+}
+
+bool Graph::isContracted() const {
+    return hierarchy != nullptr;
+}
+
+int Graph::getNumEdges() const {
+    return (int)csr->dest.size();
+}
+
+int Graph::getOutDegree(int v) const {
+    return csr->offsets[v + 1] - csr->offsets[v];
+}
+
+int Graph::edgesBegin(int v) const {
+    return csr->offsets[v];
+}
+
+int Graph::edgesEnd(int v) const {
+    return csr->offsets[v + 1];
+}
+
+int Graph::getEdgeDest(int e) const {
+    return csr->dest[e];
+}
+
+double Graph::getEdgeWeight(int e) const {
+    return csr->weight[e];
+}
+
+Airline::Id Graph::getEdgeAirline(int e) const {
+    return csr->airline[e];
+}
+
 double Graph::haversineDistanceGeneric(double lat1, double lon1, double lat2, double lon2){
     constexpr double M_PI_180 = 0.017453292519943295; // Precomputed value of PI / 180
 
@@ -156,344 +256,994 @@ double Graph::parallelHaversineDistance_(double lat1, double lon1, double lat2,
 
 
 
-int Graph::nrFlights(int src, int dest, Airline::AirlineH airlines){
+int Graph::nrFlights(SearchContext &context, int src, int dest, const AirlineMask &airlines) const {
 
     if(!findVertex(src) || !findVertex(dest))
         return {};
 
-    for (int i = 0; i < getNumVertex(); i++) {
-        vertexSet[i]->setVisited(false);
-        vertexSet[i]->distance = 0;
-    }
+    context.reset(getNumVertex());
 
-    queue<Vertex*> q;
-    q.push(vertexSet[src]);
+    const CSR &g = *csr;
+    queue<int> q;
+    q.push(src);
 
-    vertexSet[src]->visited = true;
+    context.setVisited(src);
+    context.setDistance(src, 0, -1);
 
     while(!q.empty()){
 
-        Vertex* currV = q.front();q.pop();
+        int u = q.front();q.pop();
 
-        for(const Edge &e : currV->adj){
+        for(int e = g.offsets[u]; e < g.offsets[u + 1]; e++){
 
-            if (!airlines.empty() && airlines.find(e.airline) == airlines.end()) continue;
+            if (!airlines.allows(g.airline[e])) continue;
 
-            Vertex* w = e.getDest();
+            int w = g.dest[e];
 
-            if(!vertexSet[w->getId()]->isVisited()){
+            if(!context.isVisited(w)){
                 q.push(w);
-                w->setVisited(true);
-                w->distance = currV->distance + 1;
+                context.setVisited(w);
+                context.setDistance(w, context.getDistance(u) + 1, u);
             }
         }
     }
 
-    return (int)vertexSet[dest]->distance;
+    return context.isVisited(dest) ? (int)context.getDistance(dest) : 0;
 }
 
-int Graph::airlineFlights(const string& airline){
+int Graph::airlineFlights(Airline::Id airline) const {
     int count = 0;
-    for (int i = 0 ; i < getNumVertex(); i++)
-        for (const Edge& e : vertexSet[i]->getAdj())
-            if (e.airline.getCode() == airline)
-                count++;
+    for (Airline::Id id : csr->airline)
+        if (id == airline)
+            count++;
     return count;
 }
 
-vector<string> Graph::getAirlines(int src, int dest, Airline::AirlineH airlines) {
-    vector<string> usedAirlines;
-    for (const auto& e: vertexSet[src]->adj)
-        if (e.dest->getId() == dest && (airlines.empty() || airlines.find(e.airline) != airlines.end()))
-            usedAirlines.push_back(e.airline.getCode());
+vector<Airline::Id> Graph::getAirlines(int src, int dest, const AirlineMask &airlines) const {
+    vector<Airline::Id> usedAirlines;
+    for (int e = edgesBegin(src); e < edgesEnd(src); e++)
+        if (csr->dest[e] == dest && airlines.allows(csr->airline[e]))
+            usedAirlines.push_back(csr->airline[e]);
     return usedAirlines;
 }
 
-vector<pair<int, string>> Graph::flightsPerAirport() {
-    vector<pair<int,string>> n;
+void Graph::countAirports() {
+    auto c = make_shared<AirportCounts>();
+    int n = getNumVertex();
+    c->flights.resize(n);
+    c->airlines.resize(n);
+
+    vector<int> seenAt(Airline::nrIds(), -1); // vertex that last counted the airline
+    for (int v = 0; v < n; v++) {
+        c->flights[v] = getOutDegree(v);
+        for (int e = edgesBegin(v); e < edgesEnd(v); e++) {
+            Airline::Id a = csr->airline[e];
+            if (a >= seenAt.size()) seenAt.resize(a + 1, -1);
+            if (seenAt[a] != v) {
+                seenAt[a] = v;
+                c->airlines[v]++;
+            }
+        }
+    }
+    counts = std::move(c);
+}
+
+void Graph::buildReverse() {
+    auto r = make_shared<CSR>();
+    int n = getNumVertex();
+
+    r->offsets.assign(n + 1, 0);
+    for (int d : csr->dest)
+        r->offsets[d + 1]++;
+    for (int v = 0; v < n; v++)
+        r->offsets[v + 1] += r->offsets[v];
+
+    r->dest.resize(csr->dest.size());
+    r->weight.resize(csr->dest.size());
+    r->airline.resize(csr->dest.size());
+
+    vector<int> next(r->offsets.begin(), r->offsets.end() - 1);
+    for (int u = 0; u < n; u++) {
+        for (int e = edgesBegin(u); e < edgesEnd(u); e++) {
+            int slot = next[csr->dest[e]]++;
+            r->dest[slot] = u;
+            r->weight[slot] = csr->weight[e];
+            r->airline[slot] = csr->airline[e];
+        }
+    }
+    incoming = std::move(r);
+}
 
-    for (int i = 0; i < getNumVertex(); i++){
-        int nrFlights = (int)vertexSet[i]->getAdj().size();
-        n.emplace_back(nrFlights, vertexSet[i]->getAirport().getCode());
+void Graph::buildStates() {
+    auto st = make_shared<AirlineStates>();
+    int n = getNumVertex();
+    int nrEdges = (int)csr->dest.size();
+    int nrAirlines = 0;
+    for (Airline::Id a : csr->airline) nrAirlines = max(nrAirlines, a + 1);
+
+    // one state per distinct airline landing at each airport (incoming is grouped by destination)
+    st->offsets.assign(n + 1, 0);
+    vector<int> seenAt(nrAirlines, -1); // airport that last added a state of the airline
+    vector<int> stateAt(nrAirlines);    // that state
+    vector<int> landing(nrEdges);       // state each incoming flight lands in
+    for (int v = 0; v < n; v++) {
+        for (int e = incoming->offsets[v]; e < incoming->offsets[v + 1]; e++) {
+            Airline::Id a = incoming->airline[e];
+            if (seenAt[a] != v) {
+                seenAt[a] = v;
+                stateAt[a] = (int)st->vertex.size();
+                st->vertex.push_back(v);
+                st->airline.push_back(a);
+            }
+            landing[e] = stateAt[a];
+        }
+        st->offsets[v + 1] = (int)st->vertex.size();
     }
 
-    sort(n.begin(), n.end(), [](const pair<int,string>& a, const pair<int,string>& b)
-    {return a.first > b.first;});
-    return n;
+    // buildReverse lists the flights into each airport in edge order, so the k-th flight into w is the k-th incoming
+    st->ofEdge.resize(nrEdges);
+    vector<int> next(incoming->offsets.begin(), incoming->offsets.end() - 1);
+    for (int e = 0; e < nrEdges; e++)
+        st->ofEdge[e] = landing[next[csr->dest[e]]++];
+
+    // the flights of each airport sorted by airline, so those of one airline are a run: a counting sort by airline
+    // then a stable counting sort by origin
+    next.assign(nrAirlines + 1, 0);
+    vector<int> byAirline(nrEdges);
+    for (Airline::Id a : csr->airline) next[a + 1]++;
+    for (int a = 0; a < nrAirlines; a++) next[a + 1] += next[a];
+    for (int e = 0; e < nrEdges; e++) byAirline[next[csr->airline[e]]++] = e;
+
+    vector<int> origin(nrEdges);
+    for (int v = 0; v < n; v++)
+        for (int e = csr->offsets[v]; e < csr->offsets[v + 1]; e++) origin[e] = v;
+    next.assign(csr->offsets.begin(), csr->offsets.end() - 1);
+    st->edges.resize(nrEdges);
+    for (int e : byAirline) st->edges[next[origin[e]]++] = e;
+
+    // the run of every airline leaving v, then the one of each state of v (empty if its airline does not leave v)
+    st->runBegin.assign(st->vertex.size(), 0);
+    st->runEnd.assign(st->vertex.size(), 0);
+    vector<int> runBegin(nrAirlines), runEnd(nrAirlines);
+    seenAt.assign(nrAirlines, -1);
+    for (int v = 0; v < n; v++) {
+        for (int i = csr->offsets[v]; i < csr->offsets[v + 1]; i++) {
+            Airline::Id a = csr->airline[st->edges[i]];
+            if (seenAt[a] != v) {
+                seenAt[a] = v;
+                runBegin[a] = i;
+            }
+            runEnd[a] = i + 1;
+        }
+        for (int s = st->offsets[v]; s < st->offsets[v + 1]; s++) {
+            Airline::Id a = st->airline[s];
+            if (seenAt[a] != v) continue;
+            st->runBegin[s] = runBegin[a];
+            st->runEnd[s] = runEnd[a];
+        }
+    }
+    states = std::move(st);
 }
 
-vector<pair<int,string>> Graph::airlinesPerAirport() {
+void Graph::placeAirports() {
+    constexpr double M_PI_180 = 0.017453292519943295; // Precomputed value of PI / 180
 
-    vector<pair<int,string>> nrAirlines;
+    unitVectors.resize(3 * getNumVertex());
+    for (int v = 0; v < getNumVertex(); v++) {
+        double lat = vertexSet[v]->airport.getLatitude() * M_PI_180;
+        double lon = vertexSet[v]->airport.getLongitude() * M_PI_180;
+        unitVectors[3 * v] = cos(lat) * cos(lon);
+        unitVectors[3 * v + 1] = cos(lat) * sin(lon);
+        unitVectors[3 * v + 2] = sin(lat);
+    }
+}
 
-    for (int i = 0; i < getNumVertex(); i++){
-        set<string> n;
+double Graph::chordDistance(int u, int v) const {
+    const double *p = &unitVectors[3 * u], *q = &unitVectors[3 * v];
+    double dot = p[0] * q[0] + p[1] * q[1] + p[2] * q[2];
+    // |p - q|^2 = 2 - 2 p.q for unit vectors; shrunk a little so rounding never makes it longer than the arc
+    return 6371 * sqrt(max(0.0, 2 - 2 * dot)) * (1 - 1e-9);
+}
 
-        for (const Edge& e : vertexSet[i]->getAdj())
-            n.insert(e.airline.getCode());
+double Graph::edgeWeight(int src, int dest, const AirlineMask &airlines) const {
+    double w = SearchContext::INF;
+    for (int e = edgesBegin(src); e < edgesEnd(src); e++)
+        if (csr->dest[e] == dest && airlines.allows(csr->airline[e]))
+            w = min(w, csr->weight[e]);
+    return w;
+}
 
-        nrAirlines.emplace_back(n.size(), vertexSet[i]->getAirport().getCode());
-    }
+vector<pair<int, string>> Graph::topAirports(const vector<int> &count, int k) const {
+    vector<int> ids(count.size());
+    for (size_t i = 0; i < ids.size(); i++) ids[i] = (int)i;
+    k = max(0, min(k, (int)ids.size()));
+
+    partial_sort(ids.begin(), ids.begin() + k, ids.end(), [&count](int a, int b)
+    {return count[a] != count[b] ? count[a] > count[b] : a < b;});
+
+    vector<pair<int, string>> top;
+    top.reserve(k);
+    for (int i = 0; i < k; i++)
+        top.emplace_back(count[ids[i]], vertexSet[ids[i]]->airport.getCode());
+    return top;
+}
 
-    sort(nrAirlines.begin(), nrAirlines.end(), [](const pair<int,string>& a, const pair<int,string>& b)
-    {return a.first > b.first;});
+vector<pair<int, string>> Graph::topFlightsPerAirport(int k) const {
+    return topAirports(counts->flights, k);
+}
+
+vector<pair<int, string>> Graph::topAirlinesPerAirport(int k) const {
+    return topAirports(counts->airlines, k);
+}
 
-    return nrAirlines;
+int Graph::getNrAirlines(int v) const {
+    return counts->airlines[v];
+}
+
+vector<pair<int, string>> Graph::flightsPerAirport() const {
+    return topFlightsPerAirport(getNumVertex());
+}
+
+vector<pair<int,string>> Graph::airlinesPerAirport() const {
+    return topAirlinesPerAirport(getNumVertex());
 }
 
 Graph::PairH Graph::airportsFromAirport(int source) const {
     Graph::PairH ans;
-    for(const auto& e : vertexSet[source]->getAdj())
-        ans.insert({vertexSet[e.getDest()->getId()]->airport.getCode(),
-                    vertexSet[e.getDest()->getId()]->airport.getName()});
+    for(int e = edgesBegin(source); e < edgesEnd(source); e++)
+        ans.insert({vertexSet[csr->dest[e]]->airport.getCode(),
+                    vertexSet[csr->dest[e]]->airport.getName()});
     return ans;
 }
 
-unordered_set<string> Graph::airlinesFromAirport(int i) {
-    unordered_set<string> ans;
-    for (const Edge& e : vertexSet[i]->getAdj())
-        ans.insert(e.airline.getCode());
+unordered_set<Airline::Id> Graph::airlinesFromAirport(int i) const {
+    unordered_set<Airline::Id> ans;
+    for (int e = edgesBegin(i); e < edgesEnd(i); e++)
+        ans.insert(csr->airline[e]);
     return ans;
 }
 
 unordered_set<string> Graph::countriesFromAirport(int i) const {
     unordered_set<string> ans;
-    for (const Edge& e : vertexSet[i]->getAdj()){
-        int w = e.dest->getId();
+    for (int e = edgesBegin(i); e < edgesEnd(i); e++){
+        int w = csr->dest[e];
         ans.insert(vertexSet[w]->getAirport().getCountry());
     }
     return ans;
 }
 
 
-Airport::CityH2 Graph::targetsFromAirport(int i){
+Airport::CityH2 Graph::targetsFromAirport(int i) const {
     Airport::CityH2 ans;
-    for (const auto& e : vertexSet[i]->getAdj()){
-        int w = e.dest->getId();
+    for (int e = edgesBegin(i); e < edgesEnd(i); e++){
+        int w = csr->dest[e];
         ans.insert({vertexSet[w]->airport.getCountry(), vertexSet[w]->airport.getCity()});
     }
     return ans;
 }
 
-void Graph::bfsPath(int src, Airline::AirlineH airlines){
+void Graph::bfsPath(SearchContext &context, int src, const AirlineMask &airlines) const {
 
     if(!findVertex(src))
         return;
 
-    for (int i = 0; i < getNumVertex(); i++) {
-        vertexSet[i]->distance = INT_MAX;
-        vertexSet[i]->parents.clear();
-    }
+    context.reset(getNumVertex());
 
-    queue<Vertex*> q;
-    q.push(vertexSet[src]);
+    const CSR &g = *csr;
+    queue<int> q;
+    q.push(src);
 
-    vertexSet[src]->parents = {-1};
-    vertexSet[src]->distance = 0;
+    context.setDistance(src, 0, -1);
+    context.addParent(src, -1);
 
     while(!q.empty()){
 
-        Vertex* currV = q.front();q.pop();
+        int u = q.front();q.pop();
 
-        for(const Edge &e : currV->adj){
+        for(int e = g.offsets[u]; e < g.offsets[u + 1]; e++){
 
-            if (!airlines.empty() && airlines.find(e.airline) == airlines.end()) continue;
+            if (!airlines.allows(g.airline[e])) continue;
 
-            Vertex* w = e.getDest();
+            int w = g.dest[e];
+            double d = context.getDistance(u) + 1;
 
-            if(vertexSet[w->getId()]->distance > vertexSet[currV->getId()]->distance + 1){
-                vertexSet[w->getId()]->distance = vertexSet[currV->getId()]->distance + 1;
+            if(context.getDistance(w) > d){
+                context.setDistance(w, d, u);
                 q.push(w);
-                vertexSet[w->getId()]->parents.clear();
-                vertexSet[w->getId()]->parents.push_back(currV->getId());
+                context.clearParents(w);
+                context.addParent(w, u);
             }
-            else if(vertexSet[w->getId()]->distance == vertexSet[currV->getId()]->distance + 1)
-                vertexSet[w->getId()]->parents.push_back(currV->getId());
+            else if(context.getDistance(w) == d && context.getParents(w).back() != u) // not a second flight u -> w
+                context.addParent(w, u);
         }
     }
 }
 
-void Graph::findPaths(vector<vector<int>>& paths,vector<int>& path, int v){
-
-    if (!findVertex(v)) {
-        if (find(paths.begin(),paths.end(),path) == paths.end())
-            paths.push_back(path);
-        return;
-    }
-
-    for (const auto &parent : vertexSet[v]->parents) {
-        path.push_back(v);
-        findPaths(paths,path, parent);
-        path.pop_back();
-    }
+ShortestPathDag Graph::shortestPaths(SearchContext &context, int src, int dest, const AirlineMask &airlines) const {
+    bfsPath(context, src, airlines);
+    return {context, findVertex(src) ? dest : -1, getNumVertex()};
 }
 
 
-Vertex *Graph::dijkstraFib(int src, int dest, Airline::AirlineH airlines) {
+double Graph::dijkstraFib(SearchContext &context, int src, int dest, const AirlineMask &airlines) const {
     if(!findVertex(src) || !findVertex(dest))
-        return {};
+        return SearchContext::INF;
 
-    //node id and node value(distance)
-    FibTree<Vertex *> fibHeap;
+    context.reset(getNumVertex());
 
-    for(int i = 0; i < getNumVertex(); i++){
-        vertexSet[i]->distance = INT_MAX;
-        vertexSet[i]->setVisited(false);
-        vertexSet[i]->parents.clear();
-        fibHeap.insert(vertexSet[i]);
-    }
+    //node id ordered by its distance, handles[v] is valid while v is queued
+    FibTree<int> fibHeap(getNumVertex());
+    vector<FibTree<int>::Handle> handles(getNumVertex());
 
-    vertexSet[src]->distance = 0;
-    vertexSet[src]->parents.push_back(src);
-    Vertex newKey(src);
-    newKey = *vertexSet[src];
-    newKey.distance = 0;
-    fibHeap.decreaseKey(vertexSet[src], &newKey);
+    context.setDistance(src, 0, -1);
+    handles[src] = fibHeap.insert(src, 0);
 
     while(!fibHeap.empty()){
 
-        auto u = fibHeap.extractMin()->getId();
-        vertexSet[src]->setVisited(true);
+        auto u = fibHeap.extractMin();
+        context.setVisited(u);
+        if (u == dest) break; // settled, its distance is final
 
-        for(const auto &e : vertexSet[u]->getAdj()){
+        for(int e = edgesBegin(u); e < edgesEnd(u); e++){
 
-            if (!airlines.empty() && airlines.find(e.airline) == airlines.end()) continue;
+            if (!airlines.allows(csr->airline[e])) continue;
 
-            auto v = e.getDest()->getId();
-            double w = e.getWeight();
+            auto v = csr->dest[e];
+            double w = csr->weight[e];
 
-            if(!vertexSet[v]->isVisited() && vertexSet[u]->distance + w < vertexSet[v]->distance){
+            if(!context.isVisited(v) && context.getDistance(u) + w < context.getDistance(v)){
 
-                Vertex newKey(v);
-                vertexSet[v]->distance = vertexSet[u]->distance + w;
+                bool queued = context.getDistance(v) != SearchContext::INF;
+                context.setDistance(v, context.getDistance(u) + w, u);
+                if (queued) fibHeap.decreaseKey(handles[v], context.getDistance(v));
+                else handles[v] = fibHeap.insert(v, context.getDistance(v));
 
-                auto p = vertexSet[u]->parents;
-                if (find(p.begin(), p.end(), v) == p.end()) p.push_back(v);
+            }
+        }
+    }
 
-                vertexSet[v]->parents = p;
+    return context.getDistance(dest);
+}
 
-                newKey = *vertexSet[v];
-                fibHeap.decreaseKey(vertexSet[v], &newKey);
+double Graph::dijkstra(SearchContext &context, int src, int dest, const AirlineMask &airlines) const {
+    return dijkstra(context, context.getHeap(), src, dest, airlines);
+}
 
+vector<pair<double, vector<int>>> Graph::kShortestPaths(SearchContext &context, int src, int dest, int k,
+                                                        const AirlineMask &airlines) const {
+    vector<pair<double, vector<int>>> routes;
+    if (k <= 0) return routes;
+
+    double distance = dijkstra(context, src, dest, airlines);
+    if (distance == SearchContext::INF) return routes;
+    routes.emplace_back(distance, context.getPath(dest));
+
+    set<pair<double, vector<int>>> candidates; // deviations found so far, shortest first
+    set<vector<int>> seen;                     // every route in routes or candidates
+    seen.insert(routes[0].second);
+
+    vector<char> banned(getNumVertex(), false); // airports of the prefix before the spur
+    vector<int> bannedNext;
+    while ((int)routes.size() < k) {
+        vector<int> last = routes.back().second;
+        double rootDistance = 0;
+
+        for (int i = 0; i + 1 < (int)last.size(); i++) {
+            // the routes that share the prefix last[0..i] may not leave it the same way again
+            bannedNext.clear();
+            for (const auto &route : routes)
+                if ((int)route.second.size() > i + 1 && equal(last.begin(), last.begin() + i + 1, route.second.begin()))
+                    bannedNext.push_back(route.second[i + 1]);
+            int spurNode = last[i];
+            auto skip = [&](int u, int v) {
+                return banned[v] ||
+                       (u == spurNode && find(bannedNext.begin(), bannedNext.end(), v) != bannedNext.end());
+            };
+
+            double spurDistance = dijkstra(context, context.getHeap(), spurNode, dest, airlines, false, skip);
+            if (spurDistance != SearchContext::INF) {
+                vector<int> route(last.begin(), last.begin() + i);
+                vector<int> spur = context.getPath(dest);
+                route.insert(route.end(), spur.begin(), spur.end());
+                if (seen.insert(route).second)
+                    candidates.emplace(rootDistance + spurDistance, std::move(route));
             }
+            rootDistance += edgeWeight(last[i], last[i + 1], airlines);
+            banned[last[i]] = true;
         }
-    }
+        for (int v : last) banned[v] = false;
 
-    return vertexSet[dest];
+        if (candidates.empty()) break;
+        routes.push_back(*candidates.begin());
+        candidates.erase(candidates.begin());
+    }
+    return routes;
 }
 
-Vertex *Graph::dijkstra(int src, int dest, Airline::AirlineH airlines) {
+int Graph::fewestAirlineChanges(SearchContext &context, const vector<int> &sources, const vector<int> &targets,
+                                const AirlineMask &airlines, double &distance, vector<int> &path,
+                                vector<Airline::Id> &legs) const {
+    const AirlineStates &st = *states;
+    int transfer = (int)st.vertex.size(); // node transfer + v is the transfer node of v
+    context.reset(transfer + getNumVertex());
+
+    distance = SearchContext::INF;
+    path.clear();
+    legs.clear();
+
+    vector<int> sortedTargets(targets);
+    sort(sortedTargets.begin(), sortedTargets.end());
+
+    SearchQueue &minHeap = context.getHeap();
+    auto relax = [&](int node, double d, int from) {
+        if (context.isVisited(node) || d >= context.getDistance(node)) return;
+        bool queued = context.getDistance(node) != SearchContext::INF;
+        context.setDistance(node, d, from);
+        if (queued) minHeap.decreaseKey(node, d);
+        else minHeap.insert(node, d);
+    };
+    // a change only records the transfer node for the next round, where it is queued with its distance; a transfer
+    // node recorded by an earlier round already has fewer changes
+    int round = 0;
+    vector<int> changed;
+    vector<int> changedIn(getNumVertex(), -1); // round that recorded the transfer node of each airport
+    auto change = [&](int node, double d, int from) {
+        int &in = changedIn[node - transfer];
+        if (context.isVisited(node) || (in != -1 && in != round) || d >= context.getDistance(node)) return;
+        if (in == -1) changed.push_back(node);
+        in = round;
+        context.setDistance(node, d, from);
+    };
+
+    for (int src : sources)
+        if (findVertex(src)) relax(transfer + src, 0, -1);
+
+    // round c settles, by distance, the states reached with c changes: the key is (changes, distance)
+    int found = -1;
+    while (!minHeap.empty()) {
+        while (!minHeap.empty()) {
+            int u = minHeap.extractMin();
+            context.setVisited(u);
+            double d = context.getDistance(u);
+
+            if (u >= transfer) { // any flight may be taken
+                int v = u - transfer;
+                for (int e = edgesBegin(v); e < edgesEnd(v); e++)
+                    if (airlines.allows(csr->airline[e])) relax(st.ofEdge[e], d + csr->weight[e], u);
+                continue;
+            }
 
-    if(!findVertex(src) || !findVertex(dest))
-        return {};
+            if (binary_search(sortedTargets.begin(), sortedTargets.end(), st.vertex[u])) {
+                found = u;
+                break;
+            }
+            // staying with the airline of the state (allowed, as a flight of it landed here)
+            for (int i = st.runBegin[u]; i < st.runEnd[u]; i++) {
+                int e = st.edges[i];
+                relax(st.ofEdge[e], d + csr->weight[e], u);
+            }
+            change(transfer + st.vertex[u], d, u);
+        }
+        if (found != -1) break;
+        for (int node : changed)
+            minHeap.insert(node, context.getDistance(node));
+        changed.clear();
+        round++;
+    }
+    if (found == -1) return INT_MAX;
 
-    //node id and node value(distance)
-    MinHeap<int, double> minHeap(getNumVertex(), -1);
+    int changes = 0;
+    for (int node : context.getPath(found)) {
+        if (node >= transfer) {
+            if (path.empty()) path.push_back(node - transfer); // the source
+            continue;
+        }
+        if (!legs.empty() && legs.back() != st.airline[node]) changes++;
+        path.push_back(st.vertex[node]);
+        legs.push_back(st.airline[node]);
+    }
+
+    distance = 0;
+    for (size_t i = 0; i + 1 < path.size(); i++)
+        distance += edgeWeight(path[i], path[i + 1], airlines);
+    return changes;
+}
 
-    for(int i = 0; i < getNumVertex(); i++){
-        vertexSet[i]->distance = INT_MAX;
-        vertexSet[i]->setVisited(false);
-        vertexSet[i]->parents.clear();
-        minHeap.insert(i, INT_MAX);
+vector<pair<int, double>> Graph::paretoRoutes(SearchContext &context, const vector<int> &sources,
+                                              const vector<int> &targets, const AirlineMask &airlines,
+                                              vector<vector<int>> &paths) const {
+    struct Label {
+        int vertex;
+        int prev;     // label it was reached from, -1 at a source
+        int flights;
+        double km;
+    };
+
+    context.reset(getNumVertex()); // distance = best km with at most the current flights, parent = its label
+
+    vector<pair<int, double>> frontier;
+    paths.clear();
+
+    vector<int> sortedTargets(targets);
+    sort(sortedTargets.begin(), sortedTargets.end());
+
+    vector<Label> labels;
+    vector<int> layer, next;
+    for (int src : sources) {
+        if (!findVertex(src) || context.getDistance(src) == 0) continue;
+        context.setDistance(src, 0, (int)labels.size());
+        layer.push_back((int)labels.size());
+        labels.push_back({src, -1, 0, 0});
     }
 
-    vertexSet[src]->distance = 0;
-    vertexSet[src]->parents.push_back(src);
+    double bestKm = SearchContext::INF; // distance of the last point of the frontier
+    for (int h = 1; !layer.empty(); h++) {
+        next.clear();
+        for (int l : layer) {
+            int u = labels[l].vertex;
+            double km = labels[l].km;
+            for (int e = edgesBegin(u); e < edgesEnd(u); e++) {
+                if (!airlines.allows(csr->airline[e])) continue;
+
+                int v = csr->dest[e];
+                double d = km + csr->weight[e];
+                if (d >= context.getDistance(v) || d >= bestKm) continue; // dominated
+
+                int p = context.getParent(v);
+                if (p != -1 && labels[p].flights == h) { // v already has a label in this layer
+                    labels[p].prev = l;
+                    labels[p].km = d;
+                    context.setDistance(v, d, p);
+                }
+                else {
+                    context.setDistance(v, d, (int)labels.size());
+                    next.push_back((int)labels.size());
+                    labels.push_back({v, l, h, d});
+                }
+            }
+        }
 
-    minHeap.decreaseKey(src, 0);
+        int reached = -1;
+        for (int l : next)
+            if (binary_search(sortedTargets.begin(), sortedTargets.end(), labels[l].vertex) &&
+                (reached == -1 || labels[l].km < labels[reached].km))
+                reached = l;
+        if (reached != -1) {
+            bestKm = labels[reached].km;
+            frontier.emplace_back(h, bestKm);
+            vector<int> path;
+            for (int l = reached; l != -1; l = labels[l].prev) path.push_back(labels[l].vertex);
+            reverse(path.begin(), path.end());
+            paths.push_back(std::move(path));
+        }
+        swap(layer, next);
+    }
+    return frontier;
+}
+
+vector<vector<double>> Graph::hopLimitedDistances(int src, int maxFlights, const AirlineMask &airlines,
+                                                  bool parallel) const {
+    vector<vector<double>> distances;
+    if (!findVertex(src) || maxFlights < 0)
+        return distances;
+
+    const CSR &in = *incoming;
+    int n = getNumVertex();
+
+    vector<double> weight(in.weight);
+    for (size_t e = 0; e < weight.size(); e++)
+        if (!airlines.allows(in.airline[e])) weight[e] = SearchContext::INF;
+
+    distances.reserve(min(maxFlights, n) + 1);
+    distances.emplace_back(n, SearchContext::INF);
+    distances[0][src] = 0;
+
+    // one round: the airports first..last-1 of cur from prev, tells if any of them improved
+    auto relax = [&](const vector<double> &prev, vector<double> &cur, int first, int last) {
+        bool changed = false;
+        for (int v = first; v < last; v++) {
+            double best = prev[v];
+            for (int e = in.offsets[v]; e < in.offsets[v + 1]; e++)
+                best = min(best, prev[in.dest[e]] + weight[e]);
+            cur[v] = best;
+            changed |= best < prev[v];
+        }
+        return changed;
+    };
+
+    // the workers are started once and meet at a barrier after every round; the thread completing the barrier
+    // keeps the round and decides, alone, whether another one is needed
+    int numThreads = parallel ? (int)max(1u, thread::hardware_concurrency()) : 1;
+    int chunk = (n + numThreads - 1) / numThreads;
+    vector<char> changedBy(numThreads, false);
+    vector<double> cur(n);
+    bool done = maxFlights == 0;
+    barrier sync(numThreads, [&]() noexcept {
+        bool changed = false;
+        for (char c : changedBy) changed |= c;
+        distances.push_back(std::move(cur));
+        cur.assign(n, 0);
+        done = !changed || (int)distances.size() > maxFlights;
+    });
+    auto work = [&](int t) {
+        while (!done) {
+            changedBy[t] = relax(distances.back(), cur, min(n, t * chunk), min(n, (t + 1) * chunk));
+            sync.arrive_and_wait();
+        }
+    };
 
-    while(!minHeap.empty()){
+    vector<thread> threads;
+    for (int t = 1; t < numThreads; t++)
+        threads.emplace_back(work, t);
+    work(0);
+    for (auto &thread : threads)
+        thread.join();
 
-        auto u = minHeap.extractMin();
-        vertexSet[src]->setVisited(true);
+    // a round that changed nothing is final: the larger budgets get the same distances
+    while ((int)distances.size() <= maxFlights)
+        distances.push_back(distances.back());
+    return distances;
+}
+
+double Graph::bidirectionalDijkstra(SearchContext &context, SearchContext &backward, int src, int dest,
+                                    const AirlineMask &airlines) const {
+
+    if(!findVertex(src) || !findVertex(dest))
+        return SearchContext::INF;
+
+    context.reset(getNumVertex());
+    backward.reset(getNumVertex());
+
+    SearchQueue &forwardHeap = context.getHeap();
+    SearchQueue &backwardHeap = backward.getHeap();
 
-        for(const auto &e : vertexSet[u]->getAdj()){
+    context.setDistance(src, 0, -1);
+    forwardHeap.insert(src, 0);
+    backward.setDistance(dest, 0, -1);
+    backwardHeap.insert(dest, 0);
 
-            if (!airlines.empty() && airlines.find(e.airline) == airlines.end()) continue;
+    double best = SearchContext::INF; // length of the best path found so far
+    int meet = src == dest ? src : -1;
+    if (meet != -1) best = 0;
 
-            auto v = e.getDest()->getId();
-            double w = e.getWeight();
+    while (!forwardHeap.empty() && !backwardHeap.empty()) {
+        // no path through an unsettled vertex can be shorter than best
+        if (forwardHeap.minValue() + backwardHeap.minValue() >= best) break;
 
-            if(!vertexSet[v]->isVisited() && vertexSet[u]->distance + w < vertexSet[v]->distance){
+        bool forward = forwardHeap.minValue() <= backwardHeap.minValue();
+        SearchContext &side = forward ? context : backward;
+        SearchContext &other = forward ? backward : context;
+        SearchQueue &heap = forward ? forwardHeap : backwardHeap;
+        const CSR &adj = forward ? *csr : *incoming;
 
-                vertexSet[v]->distance = vertexSet[u]->distance + w;
+        int u = heap.extractMin();
+        side.setVisited(u);
 
-                auto p = vertexSet[u]->parents;
-                if (find(p.begin(), p.end(), v) == p.end()) p.push_back(v);
+        for (int e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+            if (!airlines.allows(adj.airline[e])) continue;
 
-                vertexSet[v]->parents = p;
-                minHeap.decreaseKey(v, vertexSet[v]->distance);
+            int v = adj.dest[e];
+            double d = side.getDistance(u) + adj.weight[e];
+            if (side.isVisited(v) || d >= side.getDistance(v)) continue;
 
+            bool queued = side.getDistance(v) != SearchContext::INF;
+            side.setDistance(v, d, u);
+            if (queued) heap.decreaseKey(v, d);
+            else heap.insert(v, d);
+
+            if (other.getDistance(v) != SearchContext::INF && d + other.getDistance(v) < best) {
+                best = d + other.getDistance(v);
+                meet = v;
             }
         }
     }
 
-    return vertexSet[dest];
+    if (meet == -1)
+        return SearchContext::INF;
+
+    // continue the forward tree along the backward one, so context holds the whole route from src to dest
+    for (int x = meet, y = backward.getParent(x); x != dest; x = y, y = backward.getParent(x))
+        context.setDistance(y, context.getDistance(x) + edgeWeight(x, y, airlines), x);
+
+    return context.getDistance(dest);
+}
+
+double Graph::distance(SearchContext &context, SearchContext &backward, int src, int dest,
+                       const AirlineMask &airlines) const {
+    if (hierarchy && airlines.allowsAll())
+        return hierarchy->query(context, backward, src, dest);
+    return bidirectionalDijkstra(context, backward, src, dest, airlines);
+}
+
+vector<vector<double>> Graph::distanceMatrix(SearchContext &context, const vector<int> &sources,
+                                             const vector<int> &targets, const AirlineMask &airlines) const {
+    if (hierarchy && airlines.allowsAll())
+        return hierarchy->manyToMany(context, sources, targets);
+
+    vector<vector<double>> matrix(sources.size(), vector<double>(targets.size(), SearchContext::INF));
+    vector<int> targetCount(getNumVertex(), 0); // how many times each vertex appears in targets
+    int distinct = 0;
+    for (int t : targets)
+        if (findVertex(t) && targetCount[t]++ == 0) distinct++;
+
+    for (int i = 0; i < (int)sources.size(); i++) {
+        int src = sources[i];
+        context.reset(getNumVertex());
+        if (!findVertex(src)) continue;
+
+        SearchQueue &minHeap = context.getHeap();
+        context.setDistance(src, 0, -1);
+        minHeap.insert(src, 0);
+        int remaining = distinct;
+
+        while (!minHeap.empty() && remaining > 0) {
+            int u = minHeap.extractMin();
+            context.setVisited(u);
+            if (targetCount[u] > 0) remaining--;
+
+            for (int e = edgesBegin(u); e < edgesEnd(u); e++) {
+                if (!airlines.allows(csr->airline[e])) continue;
+
+                int v = csr->dest[e];
+                double d = context.getDistance(u) + csr->weight[e];
+                if (context.isVisited(v) || d >= context.getDistance(v)) continue;
+
+                bool queued = context.getDistance(v) != SearchContext::INF;
+                context.setDistance(v, d, u);
+                if (queued) minHeap.decreaseKey(v, d);
+                else minHeap.insert(v, d);
+            }
+        }
+
+        for (int j = 0; j < (int)targets.size(); j++)
+            if (findVertex(targets[j]) && context.isVisited(targets[j]))
+                matrix[i][j] = context.getDistance(targets[j]);
+    }
+    return matrix;
 }
 
-Vertex* Graph::aStar(int src, int dest, Airline::AirlineH airlines) {
-    //src and dest are prev verified
+vector<vector<int>> Graph::flightsMatrix(SearchContext &context, const vector<int> &sources,
+                                         const vector<int> &targets, const AirlineMask &airlines) const {
+    vector<vector<int>> matrix(sources.size(), vector<int>(targets.size(), 0));
+    vector<int> targetCount(getNumVertex(), 0);
+    int distinct = 0;
+    for (int t : targets)
+        if (findVertex(t) && targetCount[t]++ == 0) distinct++;
+
+    for (int i = 0; i < (int)sources.size(); i++) {
+        int src = sources[i];
+        context.reset(getNumVertex());
+        if (!findVertex(src)) continue;
+
+        queue<int> q;
+        q.push(src);
+        context.setVisited(src);
+        context.setDistance(src, 0, -1);
+        int remaining = distinct - (targetCount[src] > 0 ? 1 : 0);
+
+        while (!q.empty() && remaining > 0) {
+            int u = q.front(); q.pop();
+
+            for (int e = edgesBegin(u); e < edgesEnd(u); e++) {
+                if (!airlines.allows(csr->airline[e])) continue;
+
+                int w = csr->dest[e];
+                if (context.isVisited(w)) continue;
+                q.push(w);
+                context.setVisited(w);
+                context.setDistance(w, context.getDistance(u) + 1, u);
+                if (targetCount[w] > 0) remaining--;
+            }
+        }
 
-    // MinHeap with additional priority based on heuristic (Haversine distance)
-    MinHeap<int, double> minHeap(getNumVertex(), -1);
+        for (int j = 0; j < (int)targets.size(); j++)
+            if (findVertex(targets[j]) && context.isVisited(targets[j]))
+                matrix[i][j] = (int)context.getDistance(targets[j]);
+    }
+    return matrix;
+}
 
-    for (int i = 0; i < getNumVertex(); i++) {
-        vertexSet[i]->distance = INT_MAX;
-        vertexSet[i]->setVisited(false);
-        vertexSet[i]->parents.clear();
-        minHeap.insert(i, INT_MAX);
+double Graph::nearestDistance(SearchContext &context, const vector<pair<int, double>> &sources,
+                              const vector<pair<int, double>> &targets, const AirlineMask &airlines,
+                              vector<pair<int, int>> &pairs) const {
+    pairs.clear();
+    context.reset(getNumVertex());
+
+    vector<double> sinkOffset(getNumVertex(), SearchContext::INF); // offset of each target to the super-sink
+    for (auto [t, offset] : targets)
+        if (findVertex(t)) sinkOffset[t] = min(sinkOffset[t], offset);
+
+    vector<vector<int>> closest(getNumVertex()); // sorted sources at the distance of each vertex
+    SearchQueue &minHeap = context.getHeap();
+    for (auto [s, offset] : sources) {
+        if (!findVertex(s) || offset >= context.getDistance(s)) continue;
+        bool queued = context.getDistance(s) != SearchContext::INF;
+        context.setDistance(s, offset, -1);
+        closest[s] = {s};
+        if (queued) minHeap.decreaseKey(s, offset);
+        else minHeap.insert(s, offset);
     }
 
-    vertexSet[src]->distance = 0;
-    vertexSet[src]->parents.push_back(src);
+    double best = SearchContext::INF;
+    vector<int> merged;
+    // <= so that the targets tied with the best are settled too
+    while (!minHeap.empty() && minHeap.minValue() <= best) {
+        int u = minHeap.extractMin();
+        context.setVisited(u);
+
+        // a target is not reported as reached from itself, only from the other sources as close to it
+        bool fromOthers = closest[u].size() > 1 || closest[u][0] != u;
+        if (sinkOffset[u] != SearchContext::INF && fromOthers) {
+            double total = context.getDistance(u) + sinkOffset[u];
+            if (total < best) {
+                best = total;
+                pairs.clear();
+            }
+            if (total == best)
+                for (int source : closest[u])
+                    if (source != u) pairs.emplace_back(source, u);
+        }
 
-    minHeap.decreaseKey(src, 0);
+        for (int e = edgesBegin(u); e < edgesEnd(u); e++) {
+            if (!airlines.allows(csr->airline[e])) continue;
 
-    while (!minHeap.empty()) {
-        auto u = minHeap.extractMin();
-        vertexSet[u]->setVisited(true);
+            int v = csr->dest[e];
+            double d = context.getDistance(u) + csr->weight[e];
+            if (context.isVisited(v) || d > context.getDistance(v)) continue;
 
-        for (const auto &e : vertexSet[u]->getAdj()) {
-            if (!airlines.empty() && airlines.find(e.airline) == airlines.end())
+            if (d == context.getDistance(v)) {
+                // reached again at the same distance: v is as close to the sources of u
+                merged.clear();
+                set_union(closest[v].begin(), closest[v].end(), closest[u].begin(), closest[u].end(),
+                          back_inserter(merged));
+                closest[v].swap(merged);
                 continue;
+            }
+
+            bool queued = context.getDistance(v) != SearchContext::INF;
+            context.setDistance(v, d, u);
+            closest[v] = closest[u];
+            if (queued) minHeap.decreaseKey(v, d);
+            else minHeap.insert(v, d);
+        }
+    }
+    return best;
+}
+
+int Graph::nearestFlights(SearchContext &context, const vector<int> &sources, const vector<int> &targets,
+                          const AirlineMask &airlines, vector<pair<int, int>> &pairs) const {
+    pairs.clear();
+    context.reset(getNumVertex());
+
+    vector<bool> isTarget(getNumVertex(), false);
+    for (int t : targets)
+        if (findVertex(t)) isTarget[t] = true;
+
+    vector<vector<int>> closest(getNumVertex()); // sorted sources at the bfs distance of each vertex
+    vector<int> level;
+    for (int s : sources) {
+        if (!findVertex(s) || context.isVisited(s)) continue;
+        context.setVisited(s);
+        context.setDistance(s, 0, -1);
+        closest[s].push_back(s);
+        level.push_back(s);
+    }
 
-            auto v = e.getDest()->getId();
-            double w = e.getWeight();
+    vector<int> merged;
+    for (int flights = 1; !level.empty(); flights++) {
+        vector<int> next;
+        for (int u : level) {
+            for (int e = edgesBegin(u); e < edgesEnd(u); e++) {
+                if (!airlines.allows(csr->airline[e])) continue;
+
+                int w = csr->dest[e];
+                if (!context.isVisited(w)) {
+                    context.setVisited(w);
+                    context.setDistance(w, flights, u);
+                    closest[w] = closest[u];
+                    next.push_back(w);
+                }
+                else if (context.getDistance(w) == flights) {
+                    // reached again in the same level: w is as close to the sources of u
+                    merged.clear();
+                    set_union(closest[w].begin(), closest[w].end(), closest[u].begin(), closest[u].end(),
+                              back_inserter(merged));
+                    closest[w].swap(merged);
+                }
+            }
+        }
 
-            if (!vertexSet[v]->isVisited() && vertexSet[u]->distance + w < vertexSet[v]->distance) {
-                double newDistance = vertexSet[u]->distance + w;
-                double heuristic = haversineDistance(vertexSet[v]->getAirport().getLatitude(),
-                                                     vertexSet[v]->getAirport().getLongitude(),
-                                                     vertexSet[dest]->getAirport().getLatitude(),
-                                                     vertexSet[dest]->getAirport().getLongitude());
+        for (int w : next)
+            if (isTarget[w])
+                for (int s : closest[w]) pairs.emplace_back(s, w);
+        if (!pairs.empty()) return flights;
+
+        level.swap(next);
+    }
+    return INT_MAX;
+}
+
+double Graph::aStar(SearchContext &context, int src, int dest, const AirlineMask &airlines,
+                    const Landmarks *landmarks) const {
+
+    if(!findVertex(src) || !findVertex(dest))
+        return SearchContext::INF;
 
+    context.reset(getNumVertex());
 
-                vertexSet[v]->distance = newDistance;
+    auto heuristic = [&](int v) {
+        double h = chordDistance(v, dest);
+        return landmarks == nullptr ? h : max(h, landmarks->lowerBound(v, dest));
+    };
 
-                auto p = vertexSet[u]->parents;
-                if (find(p.begin(), p.end(), v) == p.end()) p.push_back(v);
-                vertexSet[v]->parents = p;
+    // node id and priority: flown distance (g) plus the lower bound of the distance to dest (h)
+    SearchQueue &minHeap = context.getHeap();
 
-                double priority = newDistance - heuristic;
-                minHeap.decreaseKey(v, priority);
+    context.setDistance(src, 0, -1);
+    minHeap.insert(src, heuristic(src));
 
+    while (!minHeap.empty()) {
+        auto u = minHeap.extractMin();
+        context.setVisited(u);
+        if (u == dest) break; // settled, its distance is final
+
+        for (int e = edgesBegin(u); e < edgesEnd(u); e++) {
+            if (!airlines.allows(csr->airline[e]))
+                continue;
+
+            auto v = csr->dest[e];
+            double w = csr->weight[e];
+
+            if (!context.isVisited(v) && context.getDistance(u) + w < context.getDistance(v)) {
+                bool queued = context.getDistance(v) != SearchContext::INF;
+                context.setDistance(v, context.getDistance(u) + w, u);
+
+                double priority = context.getDistance(v) + heuristic(v);
+                if (queued) minHeap.decreaseKey(v, priority);
+                else minHeap.insert(v, priority);
             }
         }
     }
 
-    return vertexSet[dest];
+    return context.getDistance(dest);
 }
 
 
-vector<int> Graph::bfsHighestLevel(int v, int &level){
+void Graph::shortestDistances(SearchContext &context, int src, const AirlineMask &airlines, bool incoming) const {
+    context.reset(getNumVertex());
+    if (!findVertex(src)) return;
 
-    vector<int> lca;
+    const CSR &adj = incoming ? *this->incoming : *csr;
+    SearchQueue &minHeap = context.getHeap();
+
+    context.setDistance(src, 0, -1);
+    minHeap.insert(src, 0);
+
+    while (!minHeap.empty()) {
+        int u = minHeap.extractMin();
+        context.setVisited(u);
+
+        for (int e = adj.offsets[u]; e < adj.offsets[u + 1]; e++) {
+            if (!airlines.allows(adj.airline[e])) continue;
 
-    for (int i = 0; i < getNumVertex(); i++) {
-        vertexSet[i]->setVisited(false);
-        vertexSet[i]->distance = -1.0;
+            int v = adj.dest[e];
+            double d = context.getDistance(u) + adj.weight[e];
+            if (context.isVisited(v) || d >= context.getDistance(v)) continue;
+
+            bool queued = context.getDistance(v) != SearchContext::INF;
+            context.setDistance(v, d, u);
+            if (queued) minHeap.decreaseKey(v, d);
+            else minHeap.insert(v, d);
+        }
     }
-    vertexSet[v]->setVisited(true);
+}
+
+vector<int> Graph::bfsHighestLevel(SearchContext &context, int v, int &level) const {
+
+    vector<int> lca;
+
+    context.reset(getNumVertex());
+    context.setVisited(v);
     queue<int> q;
     q.push(v);
 
@@ -507,12 +1257,12 @@ vector<int> Graph::bfsHighestLevel(int v, int &level){
 
             lca.push_back(u);
 
-            for(const auto &e : vertexSet[u]->getAdj()){
-                int w = e.getDest()->getId();
+            for(int e = edgesBegin(u); e < edgesEnd(u); e++){
+                int w = csr->dest[e];
 
-                if(!vertexSet[w]->isVisited()){
+                if(!context.isVisited(w)){
                     q.push(w);
-                    vertexSet[w]->setVisited(true);
+                    context.setVisited(w);
                 }
             }
         }
@@ -521,14 +1271,15 @@ vector<int> Graph::bfsHighestLevel(int v, int &level){
     return lca;
 }
 
-vector<Flight> Graph::maxTripSourceDestinationPairs(int diameter) {
+vector<Flight> Graph::maxTripSourceDestinationPairs(int diameter) const {
 
     vector<Flight> v;
+    SearchContext context(getNumVertex()); // reused by every bfs, each reset is O(1)
 
     for(int src = 0; src < getNumVertex(); src++){
         int level = -1;
 
-        vector<int> possibleDestinations = bfsHighestLevel(src, level);
+        vector<int> possibleDestinations = bfsHighestLevel(context, src, level);
         //TODO check unique pairs insertion
         if(diameter == level){
             for(const auto & dest : possibleDestinations)
@@ -538,7 +1289,7 @@ vector<Flight> Graph::maxTripSourceDestinationPairs(int diameter) {
     return v;
 }
 
-int Graph::diameterFlights() {
+int Graph::diameterFlights() const {
 
     int startNode = 0;
     int endNode = 0;
@@ -561,8 +1312,8 @@ int Graph::diameterFlights() {
                 endNode = u; // Update endNode when a greater depth is encountered
             }
 
-            for (const auto &e : vertexSet[u]->getAdj()) {
-                int w = e.getDest()->getId();
+            for (int e = edgesBegin(u); e < edgesEnd(u); e++) {
+                int w = csr->dest[e];
 
                 if (!visited[w]) {
                     q1.push({w, depth + 1});
@@ -588,8 +1339,8 @@ int Graph::diameterFlights() {
                 startNode = u; // Update startNode when a greater depth is encountered
             }
 
-            for (const auto &e : vertexSet[u]->getAdj()) {
-                int w = e.getDest()->getId();
+            for (int e = edgesBegin(u); e < edgesEnd(u); e++) {
+                int w = csr->dest[e];
 
                 if (!visited[w]) {
                     q1.push({w, depth + 1});
@@ -602,94 +1353,109 @@ int Graph::diameterFlights() {
 }
 
 //TODO check for all cases
-void Graph::dfsArt(int v, int index, list<int>& res, Airline::AirlineH airlines) {
-    vertexSet[v]->num = vertexSet[v]->low = index++;
-    vertexSet[v]->art = true;
+void Graph::dfsArt(int v, int index, vector<int> &num, vector<int> &low, list<int>& res, const AirlineMask &airlines) const {
+    num[v] = low[v] = index++;
     int count = 0;
 
-    for (const auto& e : vertexSet[v]->getAdj()) {
-        auto w = e.dest->getId();
+    for (int e = edgesBegin(v); e < edgesEnd(v); e++) {
+        auto w = csr->dest[e];
 
-        if (airlines.find(e.airline) != airlines.end() || airlines.empty()) {
-            if (vertexSet[w]->num == 0) {
+        if (airlines.allows(csr->airline[e])) {
+            if (num[w] == 0) {
                 count++;
-                dfsArt(w, index, res, airlines);
-                vertexSet[v]->low = min(vertexSet[v]->low, vertexSet[w]->low);
+                dfsArt(w, index, num, low, res, airlines);
+                low[v] = min(low[v], low[w]);
 
-                if (vertexSet[w]->low >= vertexSet[v]->num && std::find(res.begin(),res.end(),v) == res.end()) {
+                if (low[w] >= num[v] && std::find(res.begin(),res.end(),v) == res.end()) {
                     if(index == 2 && count > 1)
                         res.push_back(1);
                     else if (index != 2 && std::find(res.begin(),res.end(),v) == res.end())
                         res.push_back(v);
                 }
-            } else if (vertexSet[v]->art) { // Ignore edge to the parent in DFS tree
-                vertexSet[v]->low = min(vertexSet[v]->low, vertexSet[w]->num);
+            } else {
+                low[v] = min(low[v], num[w]);
             }
         }
     }
 }
 
-list<int> Graph::articulationPoints(const Airline::AirlineH& airlines) {
+list<int> Graph::articulationPoints(const AirlineMask& airlines) const {
     list<int> res;
-
-    for(int i = 0; i < getNumVertex(); i++){
-        vertexSet[i]->setVisited(false);
-        vertexSet[i]->art = false;
-        vertexSet[i]->num = 0;
-        vertexSet[i]->low = {};
-    }
+    vector<int> num(getNumVertex(), 0);
+    vector<int> low(getNumVertex(), 0);
 
     int index = 1;
 
     for(int i = 0; i < getNumVertex(); i++)
-        if (vertexSet[i]->num == 0)
-            dfsArt(i, index,res, airlines);
+        if (num[i] == 0)
+            dfsArt(i, index, num, low, res, airlines);
 
     return res;
 }
 
 
-void Graph::printPath(vector<int> path, const Airline::AirlineH& airlines) {
+void Graph::printPath(vector<int> path, const AirlineMask& airlines) const {
     for (int i = 0; i < path.size() - 1; i++){
         auto possibleAirlines = getAirlines(path[i],path[i+1],airlines);
         printf("\033[1m\033[46m %s \033[0m", vertexSet[path[i]]->airport.getCode().c_str());
         cout <<" --- (";
         for (int j = 0; j < possibleAirlines.size() - 1; j++)
-            printf("\033[1m\033[32m %s \033[0m |",possibleAirlines[j].c_str());
-        printf("\033[1m\033[32m %s \033[0m",possibleAirlines[possibleAirlines.size()-1].c_str());
+            printf("\033[1m\033[32m %s \033[0m |",Airline::codeOf(possibleAirlines[j]).c_str());
+        printf("\033[1m\033[32m %s \033[0m",Airline::codeOf(possibleAirlines[possibleAirlines.size()-1]).c_str());
         cout << ") --- ";
     }
     printf("\033[1m\033[46m %s \033[0m\n\n", vertexSet[path[path.size() - 1]]->airport.getCode().c_str());
 }
 
 
-void Graph::printPathsByFlights(int& nrPath, int start, int end, const Airline::AirlineH& airlines) {
-    vector<int> path;
-    vector<vector<int> > paths;
-
-    bfsPath(start,airlines);
-    findPaths(paths,path,end);
+uint64_t Graph::printPathsByFlights(SearchContext &context, int& nrPath, int start, int end, const AirlineMask& airlines,
+                                   int limit) const {
+    ShortestPathDag dag = shortestPaths(context, start, end, airlines);
 
-    Parser parser;
-    auto map = parser.getMap();
-    for (auto v : paths) {
-        reverse(v.begin(), v.end());
+    vector<int> path;
+    auto it = dag.paths(nrPath < limit ? limit - nrPath : 0);
+    while (it.next(path)) {
         cout << " Trajeto nº" << ++nrPath << ": ";
-        printPath(v,airlines);
+        printPath(path,airlines);
     }
+    return dag.getNrPaths();
 }
 
 
-void Graph::printPathsByDistance(int& nrPath, int start, int end, const Airline::AirlineH& airlines) {
-    Vertex* v = dijkstra(start,end,airlines);
+void Graph::printPathsByDistance(SearchContext &context, SearchContext &backward, int& nrPath, int start, int end,
+                                 const AirlineMask& airlines) const {
+    distance(context, backward, start, end, airlines);
+    vector<int> path = context.getPath(end);
 
-    if (v->parents.empty()) {
+    if (path.empty()) {
         cout << " Não existem voos\n\n";
         return;
     }
 
     cout << " Trajeto nº" << ++nrPath << ": ";
-    printPath(v->parents, airlines);
+    printPath(path, airlines);
 
 }
 
+
+void Graph::printRoute(const vector<int> &path, const vector<Airline::Id> &legs) const {
+    if (path.empty()) return;
+    for (size_t i = 0; i + 1 < path.size(); i++){
+        printf("\033[1m\033[46m %s \033[0m", vertexSet[path[i]]->airport.getCode().c_str());
+        cout <<" --- (";
+        printf("\033[1m\033[32m %s \033[0m",Airline::codeOf(legs[i]).c_str());
+        cout << ") --- ";
+    }
+    printf("\033[1m\033[46m %s \033[0m\n\n", vertexSet[path[path.size() - 1]]->airport.getCode().c_str());
+}
+
+void Graph::printAlternativePaths(SearchContext &context, int start, int end, int k, const AirlineMask& airlines) const {
+    auto routes = kShortestPaths(context, start, end, k + 1, airlines);
+
+    for (int i = 1; i < (int)routes.size(); i++) {
+        cout << " Alternativa nº" << i << " (" << routes[i].first << " km): ";
+        printPath(routes[i].second, airlines);
+    }
+    if (!routes.empty() && (int)routes.size() <= k) cout << " Não existem mais trajetos\n\n";
+}
+
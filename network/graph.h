@@ -16,65 +16,112 @@
 #include <algorithm>
 #include <climits>
 #include <utility>
+#include <memory>
 #include <immintrin.h>
 #include "../classes/airport.h"
 #include "../classes/airline.h"
 #include "../classes/Fibtree.h"
-#include "../classes/Minheap.h"
+#include "search_context.h"
+#include "shortest_path_dag.h"
 
 
 class Edge;
 class Vertex;
 class Graph;
+class Landmarks;
+class ContractionHierarchy;
 
 class Edge {
     Vertex * dest{};       // destination vertex
     double weight{};       // edge weight
-    Airline airline;
+    Airline::Id airline{}; // interned airline code
 
 public:
-    Edge(Vertex *d, Airline airline, double w);
+    Edge(Vertex *d, Airline::Id airline, double w);
     [[nodiscard]] Vertex *getDest() const;
     [[nodiscard]] double getWeight() const;
-    [[nodiscard]] Airline getAirline() const;
+    [[nodiscard]] Airline::Id getAirline() const;
     friend class Graph;
     friend class Vertex;
 };
 class Vertex {
     int id;
     Airport airport = Airport(""); // content
-    list<Edge > adj;    // list of outgoing edges
-    int maxDepth{};     // mark the node max depth
-    bool visited{};          // auxiliary field
-    bool processing{};       // auxiliary field
-    int num = 0;             // to use in articulation points
-    int low{};               // to use in articulation points
-    bool art{};                // to use in articulation points
-    double distance{};
-    vector<int> parents; //to use in bfsPath
-    vector<int> maxTripDestinations;
+    list<Edge > adj;    // outgoing edges added before the graph is frozen (see Graph::freeze)
 
     /*!
      * @note Auxiliary function to add an outgoing edge to a vertex (this),
      *       with a given destination vertex (d), the airline associated and the edge weight (w).
      */
-    void addEdge(Vertex *dest, const Airline& airline, double w);
+    void addEdge(Vertex *dest, Airline::Id airline, double w);
 
 public:
     explicit Vertex(int id);
     Vertex(int id, Airport airport);
     [[nodiscard]] int getId() const;
-    [[nodiscard]] double getDistance() const;
     Airport getAirport();
-    [[nodiscard]] bool isVisited() const;
-    void setVisited(bool v);
-    [[nodiscard]] bool isProcessing() const;
-    void setProcessing(bool p);
-    [[nodiscard]] const list<Edge> &getAdj() const;
     friend class Graph;
 
 };
 
+/**
+ * @brief Frozen compressed sparse row (CSR) adjacency of the graph.
+ * @details The outgoing edges of vertex v are the indexes [offsets[v], offsets[v + 1]) of the
+ * @details dest, weight and airline arrays, so a traversal walks contiguous memory instead of linked nodes.
+ * @details airline holds the interned airline id (see Airline::intern) of each edge.
+ */
+struct CSR {
+    vector<int> offsets;            // size |V| + 1
+    vector<int> dest;               // size |E|
+    vector<double> weight;          // size |E|
+    vector<Airline::Id> airline;    // size |E|
+};
+
+/**
+ * @brief Flights collected by a loader in file order, before the CSR is built (see Graph::freeze).
+ */
+struct EdgeList {
+    vector<int> source;
+    vector<int> dest;
+    vector<double> weight;
+    vector<Airline::Id> airline;
+
+    void reserve(size_t n) {source.reserve(n); dest.reserve(n); weight.reserve(n); airline.reserve(n);}
+    void push(int s, int d, double w, Airline::Id a) {source.push_back(s); dest.push_back(d); weight.push_back(w); airline.push_back(a);}
+    [[nodiscard]] size_t size() const {return source.size();}
+};
+
+/**
+ * @brief Per-airport counts behind the airport rankings, computed once when the graph is frozen.
+ */
+struct AirportCounts {
+    vector<int> flights;    // out-degree of each vertex
+    vector<int> airlines;   // number of distinct airlines departing from each vertex
+};
+
+/**
+ * @brief (airport, airline) states of the airline change searches, computed once when the graph is frozen.
+ *
+ * A state is an airport together with the airline of the flight that landed there, and only the pairs that some
+ * flight produces exist, so there are at most |E| states instead of |V| times the number of airlines.
+ */
+struct AirlineStates {
+    vector<int> offsets;            // states of v are offsets[v]..offsets[v+1], size |V| + 1
+    vector<int> vertex;             // airport of each state
+    vector<Airline::Id> airline;    // airline of each state
+    vector<int> ofEdge;             // state a flight lands in, size |E|
+    vector<int> edges;              // flights of each airport (same ranges as CSR::offsets) sorted by airline
+    vector<int> runBegin;           // flights of the state's airline leaving its airport are
+    vector<int> runEnd;             // edges[runBegin[s]..runEnd[s])
+};
+
+/**
+ * Flight filter of Graph::dijkstra that skips no flight.
+ */
+struct AnyFlight {
+    bool operator()(int, int) const {return false;}
+};
+
 class Flight{
 public:
     //!@brief used only for max trip source and destination pairs functionality
@@ -86,6 +133,78 @@ class Graph {
 
     vector<Vertex *> vertexSet;    // vertex set
     const int size = 3019;
+    shared_ptr<const CSR> csr = make_shared<CSR>(); // frozen adjacency, shared between copies of the graph
+    shared_ptr<const AirportCounts> counts = make_shared<AirportCounts>(); // rankings data of the frozen adjacency
+    shared_ptr<const CSR> incoming = make_shared<CSR>(); // incoming edges: dest holds the origin of each flight
+    shared_ptr<const AirlineStates> states = make_shared<AirlineStates>(); // states of the airline change searches
+    shared_ptr<const ContractionHierarchy> hierarchy; // built by contract(), dropped by every freeze
+
+    /**
+     * Rebuilds incoming from csr (counting sort by destination), called by every freeze.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|V|+|E|)</b>, V -> number of nodes, E -> number of edges
+     * </pre>
+     */
+    void buildReverse();
+
+    /**
+     * Rebuilds states from csr and incoming, called by every freeze.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|V|+|E|+A)</b>, V -> number of nodes, E -> number of edges, A -> number of airlines
+     * </pre>
+     */
+    void buildStates();
+
+    vector<double> unitVectors; // (x, y, z) of each airport on the unit sphere, 3 entries per vertex
+
+    /**
+     * Rebuilds unitVectors from the airport coordinates, called by every freeze.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|V|)</b>, V -> number of nodes
+     * </pre>
+     */
+    void placeAirports();
+
+    /**
+     * Lower bound of the flown distance from u to v: the length of the chord between the two airports, which is
+     * never longer than the arc (the haversine weight of a flight). Being a straight line distance, it is also
+     * consistent, so A* never has to settle a vertex twice.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(1)</b>, a dot product and a square root
+     * </pre>
+     */
+    [[nodiscard]] double chordDistance(int u, int v) const;
+
+    /**
+     * Gets the weight of the lightest allowed flight from src to dest.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(d)</b>, d -> out-degree of src
+     * </pre>
+     */
+    [[nodiscard]] double edgeWeight(int src, int dest, const AirlineMask &airlines) const;
+
+    /**
+     * Recomputes counts from csr, called by every freeze.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|V|+|E|)</b>, V -> number of nodes, E -> number of edges
+     * </pre>
+     */
+    void countAirports();
+
+    /**
+     * Selects the k airports with the highest count (ties by vertex id) with a partial sort.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|V|*log(k))</b>, V -> number of nodes
+     * </pre>
+     */
+    [[nodiscard]] vector<pair<int, string>> topAirports(const vector<int> &count, int k) const;
 
 public:
 
@@ -96,12 +215,72 @@ public:
     // return values are not accidentally overlooked.
     [[nodiscard]] bool findVertex(const int &in) const;
 
-    bool addFlight(const int &src, const int &dest, const Airline &airline, double w);
+    bool addFlight(const int &src, const int &dest, Airline::Id airline, double w);
     bool addAirport(const int &src, const Airport &airport);
 
     [[nodiscard]] int getNumVertex() const;
     [[nodiscard]] vector<Vertex * > getVertexSet() const;
 
+    /**
+     * Moves the flights added with addFlight into a compressed sparse row adjacency (offsets array plus contiguous
+     * destination, weight and airline arrays), used by every algorithm of the graph.
+     * Must be called once after all the flights are added; the per-vertex edge lists are released.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|V|+|E|)</b>, V -> number of nodes, E -> number of edges
+     * </pre>
+     */
+    void freeze();
+
+    /**
+     * Installs an adjacency that was already built, e.g. read from a Snapshot.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(1)</b>
+     * </pre>
+     * @param frozen - adjacency of the vertices already added with addAirport
+     */
+    void freeze(CSR frozen);
+
+    /**
+     * Builds the CSR straight from flight lists with a counting sort by source: the out-degrees are counted,
+     * prefix-summed into the offsets and every edge is placed at its slot.
+     * The sort is stable, so the edges of a vertex keep the order of the parts and, inside each part, their order.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|V|+|E|)</b>, V -> number of nodes, E -> number of edges
+     * </pre>
+     * @param parts - flights of the vertices already added with addAirport
+     */
+    void freeze(const vector<EdgeList> &parts);
+
+    [[nodiscard]] const CSR &getCSR() const;
+
+    /**
+     * Installs the ContractionHierarchy of the frozen flights (built from this graph or loaded for the same data),
+     * used from then on by distance and printPathsByDistance for the queries without airline filter.
+     * Copies of the graph made afterwards share it.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(1)</b>
+     * </pre>
+     */
+    void setHierarchy(shared_ptr<const ContractionHierarchy> contracted);
+
+    [[nodiscard]] bool isContracted() const;
+
+    [[nodiscard]] int getNumEdges() const;
+    [[nodiscard]] int getOutDegree(int v) const;
+
+    /**
+     * @brief Outgoing edges of v are the edge indexes in [edgesBegin(v), edgesEnd(v)).
+     */
+    [[nodiscard]] int edgesBegin(int v) const;
+    [[nodiscard]] int edgesEnd(int v) const;
+    [[nodiscard]] int getEdgeDest(int e) const;
+    [[nodiscard]] double getEdgeWeight(int e) const;
+    [[nodiscard]] Airline::Id getEdgeAirline(int e) const;
+
 
     /**
      * Calculates the distance between two airports given the latitude and longitude, using haversine formula\n \n
@@ -123,12 +302,13 @@ public:
      * <pre>
      *      <b>O(|V|+|E|)</b>, V -> number of nodes, E -> number of edges
      * </pre>
+     * @param context - caller-owned search state, reset by the call
      * @param src - source node / node of source airport
      * @param dest - target node
-     * @param airlines - unordered set of airlines to use (if empty, use all airlines)
+     * @param airlines - mask of the airlines to use
      * @return minimum number of flights between source airport and target airport using airlines
      */
-    int nrFlights(int src, int dest, Airline::AirlineH airlines);
+    int nrFlights(SearchContext &context, int src, int dest, const AirlineMask &airlines) const;
 
     /**
      * Calculates the number of flights of a specific airline\n\n
@@ -136,30 +316,61 @@ public:
      * <pre>
      *      <b>O(|E|)</b>, E -> number of edges
      * </pre>
-     * @param airline
+     * @param airline - interned airline id
      * @return number of flights of a specific airline
      */
-    int airlineFlights(const string& airline);
+    int airlineFlights(Airline::Id airline) const;
+
+    /**
+     * Gets the k airports with the most departures, from the counts cached when the graph was frozen.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|V|*log(k))</b>, V -> number of nodes
+     * </pre>
+     * @param k - size of the top (clamped to the number of airports)
+     * @return vector of pair<Number of departures,Airport Code> by descending order of number of flights
+     */
+    vector<pair<int, string>> topFlightsPerAirport(int k) const;
+
+    /**
+     * Gets the k airports served by the most airlines, from the counts cached when the graph was frozen.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|V|*log(k))</b>, V -> number of nodes
+     * </pre>
+     * @param k - size of the top (clamped to the number of airports)
+     * @return vector of pair<Number of airlines,Airport Code> by descending order of number of airlines
+     */
+    vector<pair<int, string>> topAirlinesPerAirport(int k) const;
 
     /**
-     * Calculates the number of departures of each airport.\n\n
+     * Gets the number of distinct airlines departing from v.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(1)</b>
+     * </pre>
+     */
+    [[nodiscard]] int getNrAirlines(int v) const;
+
+    /**
+     * Ranks every airport by number of departures.\n\n
      * <b>Complexity\n</b>
      * <pre>
      *      <b>O(|V|*log(|V|))</b>, V -> number of nodes
      * </pre>
      * @return ordered vector of pair<Number of departures,Airport Code> by descending order of number of flights
      */
-    vector<pair<int, string>> flightsPerAirport();
+    vector<pair<int, string>> flightsPerAirport() const;
 
     /**
-     * Calculates the number of airlines that work with each airport.\n\n
+     * Ranks every airport by number of airlines that work with it.\n\n
      * <b>Complexity\n</b>
      * <pre>
-     *      <b>O(|V| + |E| + n * log(n))</b>, V -> number of nodes, E -> number of edges, n -> size of nrAirlines
+     *      <b>O(|V|*log(|V|))</b>, V -> number of nodes
      * </pre>
      * @return ordered vector of pair<Number of airlines,Airport Code> by descending order of number of airlines
      */
-    vector<pair<int, string>> airlinesPerAirport();
+    vector<pair<int, string>> airlinesPerAirport() const;
 
 
     /*!                                                 */
@@ -173,17 +384,18 @@ public:
     * <pre>
     *      <b>O(|V| + |E|)</b>, V -> number of nodes, E -> number of edges
     * </pre>
+    * @param context - caller-owned search state, reset by the call
     * @param v - source node
     * @param max - number of flights
     * @note the entities can be airports, countries or cities. The use of this function runs as follows.
-    * @details  Airport::AirportH airports = graph.listReachableEntities<Airport::AirportH>(sourceNode, maxFlights);
-    * @details  Airport::CityH2 cities = graph.listReachableEntities<Airport::CityH2>(sourceNode, maxFlights);\n
-    * @details  std::set<std::string> countries = graph.listReachableEntities<std::set<std::string>>(sourceNode, maxFlights);
+    * @details  Airport::AirportH airports = graph.listReachableEntities<Airport::AirportH>(context, sourceNode, maxFlights);
+    * @details  Airport::CityH2 cities = graph.listReachableEntities<Airport::CityH2>(context, sourceNode, maxFlights);\n
+    * @details  std::set<std::string> countries = graph.listReachableEntities<std::set<std::string>>(context, sourceNode, maxFlights);
     * @return set of reachable airports using "max" number of flights.
     *
     */
     template <typename Container>
-    Container listReachableEntities(int v, int max);
+    Container listReachableEntities(SearchContext &context, int v, int max) const;
 
     struct PairStringHash{
         int operator()(const pair<string,string> &b) const {
@@ -217,9 +429,9 @@ public:
      *      <b>O(|E|)</b>, E -> number of edges of node i
      * </pre>
      * @param i - source node
-     * @return set of all the different airlines
+     * @return set of the ids of all the different airlines
      */
-    unordered_set<string> airlinesFromAirport(int i);
+    unordered_set<Airline::Id> airlinesFromAirport(int i) const;
 
     /**
      * Calculates the different cities that are reachable from an airport within 1 flight\n\n
@@ -230,7 +442,7 @@ public:
      * @param i - source node
      * @return set of all the different cities
      */
-    Airport::CityH2 targetsFromAirport(int i);
+    Airport::CityH2 targetsFromAirport(int i) const;
 
     /**
      * Calculates the different countries that are reachable from an airport within 1 flight\n\n
@@ -244,44 +456,290 @@ public:
     unordered_set<string> countriesFromAirport(int i) const;
 
     /**
-     * Stores in the parents variable the possible flight candidates using bfs. Parents who also have possible flight candidates
-     * allowing us to get all the possible flights from a certain source.\n\n
+     * Stores in the parents of the context the possible flight candidates using bfs. Parents who also have possible flight candidates
+     * allowing us to get all the possible flights from a certain source. Several flights between the same two
+     * airports give a single parent.\n\n
      * <b>Complexity\n</b>
      * <pre>
      *      <b>O(|V|+|E|)</b>, V -> number of nodes, E -> number of edges
      * </pre>
+     * @param context - caller-owned search state, reset by the call
      * @param src - source node
-     * @param airlines - unordered set of airlines to use (if empty, use all airlines)
+     * @param airlines - mask of the airlines to use
      */
-    void bfsPath(int src, Airline::AirlineH airlines);
+    void bfsPath(SearchContext &context, int src, const AirlineMask &airlines) const;
 
     /**
-     * Stores in paths all possible paths to node v.\n\n
+     * Finds every route with the fewest flights from src to dest, as a ShortestPathDag over the parents of bfsPath
+     * (the routes are counted, not listed).\n\n
      * <b>Complexity\n</b>
      * <pre>
-     *      <b>O(n)</b> n -> paths vector size
+     *      <b>O(|V|+|E|)</b>, V -> number of nodes, E -> number of edges
      * </pre>
-     * @param paths - vector of paths that are possible
-     * @param path - current path
-     * @param v - target node
+     * @param context - caller-owned search state, reset by the call
+     * @param src - source node
+     * @param dest - target node
+     * @param airlines - mask of the airlines to use
+     * @return the routes (not reachable if dest cannot be reached)
      */
-    void findPaths(vector<vector<int>>& paths, vector<int>& path, int v);
+    ShortestPathDag shortestPaths(SearchContext &context, int src, int dest, const AirlineMask &airlines) const;
 
     /**
-     * Calculates the minimum flown distance between source airport and target airport using airlines \n \n
+     * Calculates the minimum flown distance between source airport and target airport using airlines.
+     * Vertices enter the heap when they are first reached and the search stops when dest is settled.\n \n
      * <b>Complexity\n</b>
      * <pre>
 
      *      <b>O(|E|log(|V|))</b>, V -> number of nodes and E is the number of Edges
      * </pre>
+     * @param context - caller-owned search state, reset by the call (context.getPath(dest) gives the route)
+     * @param src - source node / node of source airport
+     * @param dest - target node
+     * @param airlines - mask of the airlines to use
+     * @return minimum flown distance between source airport and target airport using airlines (SearchContext::INF if unreachable)
+     */
+    double dijkstra(SearchContext &context, int src, int dest, const AirlineMask &airlines) const;
+
+    /**
+     * Same search as dijkstra, with the priority queue given by the caller: IndexedHeap, SearchQueue, RadixHeap, or,
+     * when hops is set, BucketQueue (every flight weighs 1, so the result is the number of flights of nrFlights).
+     * The queue is reset by the call and only needs reset, empty, insert, decreaseKey and extractMin. skip removes
+     * flights beyond the airline filter, as the spur searches of kShortestPaths do.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|E|*I + |V|*X)</b>, I -> cost of an insert/decreaseKey of Queue, X -> cost of an extractMin
+     * </pre>
+     * @tparam Queue - priority queue of vertex ids with double values
+     * @tparam Skip - callable bool(int u, int v)
+     * @param context - caller-owned search state, reset by the call (context.getPath(dest) gives the route)
+     * @param queue - caller-owned priority queue
+     * @param src - source node / node of source airport
+     * @param dest - target node
+     * @param airlines - mask of the airlines to use
+     * @param hops - count flights instead of kilometres
+     * @param skip - true for a flight u -> v that may not be taken (by default every flight may)
+     * @return minimum flown distance (or number of flights) from src to dest (SearchContext::INF if unreachable)
+     */
+    template <class Queue, class Skip = AnyFlight>
+    double dijkstra(SearchContext &context, Queue &queue, int src, int dest, const AirlineMask &airlines,
+                    bool hops = false, Skip skip = {}) const;
+
+    /**
+     * Calculates the k shortest loopless routes (by flown distance) from src to dest with Yen's algorithm: the
+     * i-th route is the best deviation of a previous route that leaves it at one of its airports (the spur) and
+     * never uses a flight already taken from the same prefix nor goes back to an airport of the prefix.
+     * Every spur search is a dijkstra with context that skips the flights into the prefix and the flights already
+     * taken from it; context only keeps parent ids, and the routes are rebuilt at the end.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(k*L*|E|log(|V|))</b>, L -> number of airports of a route, V -> number of nodes and E is the number of Edges
+     * </pre>
+     * @param context - caller-owned search state, reset by the call
+     * @param src - source node
+     * @param dest - target node
+     * @param k - number of routes
+     * @param airlines - mask of the airlines to use
+     * @return up to k pairs (flown distance, route from src to dest), by increasing distance
+     */
+    vector<pair<double, vector<int>>> kShortestPaths(SearchContext &context, int src, int dest, int k,
+                                                     const AirlineMask &airlines) const;
+
+    /**
+     * Finds the route from one of the sources to one of the targets with the fewest airline changes, and the
+     * shortest flown distance among those. Dijkstra runs over the AirlineStates with the key (changes, distance):
+     * from (v, a) the flights of a cost their distance, and a change goes through a transfer node of v, from where
+     * any flight leaves. The states with c changes are settled, by distance, in round c, and a change only queues
+     * the transfer node for round c+1, so any number of changes is counted exactly. Every flight is scanned once
+     * per state of its airline and once per transfer, and the product graph is never built. The first flight from
+     * a source is not a change.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O((S+|E|)log(S))</b>, S -> number of (airport, airline) states, E -> number of edges
+     * </pre>
+     * @param context - caller-owned search state, reset by the call (sized for the states)
+     * @param sources - source nodes
+     * @param targets - target nodes (a route has at least one flight)
+     * @param airlines - mask of the airlines to use
+     * @param distance - set to the flown distance of the route
+     * @param path - set to the airports of the route, from the source to the target
+     * @param legs - set to the airline of each flight of the route (legs[i] flies path[i] -> path[i+1])
+     * @return the number of airline changes (INT_MAX if no target is reachable)
+     */
+    int fewestAirlineChanges(SearchContext &context, const vector<int> &sources, const vector<int> &targets,
+                             const AirlineMask &airlines, double &distance, vector<int> &path,
+                             vector<Airline::Id> &legs) const;
+
+    /**
+     * Finds the Pareto frontier of (number of flights, flown distance) from the sources to the targets in one search:
+     * the routes for which no other route has as few flights and a smaller distance. Labels are set one hop layer
+     * at a time; a vertex gets a label in layer h only if it beats its distance with fewer flights, and no label
+     * goes on once it is as long as the shortest route already found, so the layers stop soon after the flights of
+     * the shortest route by distance.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(H*|E|)</b>, H -> number of layers (flights of the shortest route), E -> number of edges
+     * </pre>
+     * @param context - caller-owned search state, reset by the call
+     * @param sources - source nodes
+     * @param targets - target nodes (a route has at least one flight)
+     * @param airlines - mask of the airlines to use
+     * @param paths - set to the route of each point of the frontier
+     * @return the points (flights, distance) of the frontier, by increasing flights and decreasing distance
+     */
+    vector<pair<int, double>> paretoRoutes(SearchContext &context, const vector<int> &sources, const vector<int> &targets,
+                                           const AirlineMask &airlines, vector<vector<int>> &paths) const;
+
+    /**
+     * Calculates, for every hop budget h up to maxFlights, the minimum flown distance from src to every airport with
+     * at most h flights, with Bellman-Ford rounds. Round h pulls, for every airport, the best of its incoming flights
+     * from the distances of round h-1, running over the contiguous arrays of the incoming CSR; the airline filter is
+     * applied once to a copy of the weights (INF for a filtered flight), so the inner loop has no branch. The
+     * airports of a round are independent: with parallel they are split among the cores, by workers started once
+     * per call that meet at a barrier after every round. The rounds stop early when one changes nothing.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(K*(|V|+|E|))</b>, K -> maxFlights, V -> number of nodes, E -> number of edges
+     * </pre>
+     * @param src - source node
+     * @param maxFlights - largest hop budget K
+     * @param airlines - mask of the airlines to use
+     * @param parallel - run every round with one thread per core
+     * @return distances[h][v] = minimum distance from src to v with at most h flights (SearchContext::INF if none),
+     * for h = 0..maxFlights (empty if src does not exist)
+     */
+    vector<vector<double>> hopLimitedDistances(int src, int maxFlights, const AirlineMask &airlines,
+                                               bool parallel = false) const;
+
+    /**
+     * Same result as dijkstra, but grows a forward search from src and a backward search from dest (over the
+     * incoming edges) and stops as soon as the two smallest queued distances add up to the best meeting found,
+     * so only the vertices closer than about half the answer are settled on each side.
+     * The path is stitched into context, so context.getPath(dest) gives the route as with dijkstra.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|E|log(|V|))</b>, V -> number of nodes and E is the number of Edges (worst case)
+     * </pre>
+     * @param context - caller-owned forward search state, reset by the call
+     * @param backward - caller-owned backward search state, reset by the call
      * @param src - source node / node of source airport
      * @param dest - target node
-     * @param airlines - unordered set of airlines to use (if empty, use all airlines)
-     * @return minimum flown distance between source airport and target airport using airlines
+     * @param airlines - mask of the airlines to use
+     * @return minimum flown distance between source airport and target airport using airlines (SearchContext::INF if unreachable)
      */
-    Vertex* dijkstra(int src, int dest, Airline::AirlineH airlines);
+    double bidirectionalDijkstra(SearchContext &context, SearchContext &backward, int src, int dest,
+                                 const AirlineMask &airlines) const;
 
-    Vertex* dijkstraFib(int src, int dest, Airline::AirlineH airlines);
+    /**
+     * Calculates the minimum flown distance between source airport and target airport using airlines, with the
+     * contraction hierarchy when the graph is contracted and no airline is filtered out, with
+     * bidirectionalDijkstra otherwise (the shortcuts do not know which airlines fly them).
+     * Either way context.getPath(dest) gives the route.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(U*log(U))</b>, U -> vertices above src and dest in the hierarchy
+     *      <b>O(|E|log(|V|))</b>, V -> number of nodes and E is the number of Edges, without hierarchy
+     * </pre>
+     * @param context - caller-owned forward search state, reset by the call
+     * @param backward - caller-owned backward search state, reset by the call
+     * @param src - source node / node of source airport
+     * @param dest - target node
+     * @param airlines - mask of the airlines to use
+     * @return minimum flown distance between source airport and target airport using airlines (SearchContext::INF if unreachable)
+     */
+    double distance(SearchContext &context, SearchContext &backward, int src, int dest,
+                    const AirlineMask &airlines) const;
+
+    /**
+     * Calculates the minimum flown distance from every source to every target in one go: with the buckets of the
+     * contraction hierarchy when the graph is contracted and no airline is filtered out, otherwise with one
+     * Dijkstra per source that stops once every target is settled.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O((|S|+|T|)*U*log(U))</b>, U -> vertices above a source or target in the hierarchy
+     *      <b>O(|S|*|E|log(|V|))</b>, V -> number of nodes and E is the number of Edges, without hierarchy
+     * </pre>
+     * @param context - caller-owned search state, reset by the call
+     * @param sources - source nodes
+     * @param targets - target nodes
+     * @param airlines - mask of the airlines to use
+     * @return matrix[i][j] = distance from sources[i] to targets[j] (SearchContext::INF if unreachable)
+     */
+    vector<vector<double>> distanceMatrix(SearchContext &context, const vector<int> &sources,
+                                          const vector<int> &targets, const AirlineMask &airlines) const;
+
+    /**
+     * Calculates the minimum number of flights from every source to every target, with one bfs per source that
+     * stops once every target is reached.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|S|*(|V|+|E|))</b>, S -> number of sources, V -> number of nodes, E -> number of edges
+     * </pre>
+     * @param context - caller-owned search state, reset by the call
+     * @param sources - source nodes
+     * @param targets - target nodes
+     * @param airlines - mask of the airlines to use
+     * @return matrix[i][j] = flights from sources[i] to targets[j] (0 if unreachable, as nrFlights)
+     */
+    vector<vector<int>> flightsMatrix(SearchContext &context, const vector<int> &sources,
+                                      const vector<int> &targets, const AirlineMask &airlines) const;
+
+    /**
+     * Calculates the minimum flown distance from a set of sources to a set of targets with a single Dijkstra,
+     * as if a virtual super-source had a flight of length offset to every source and every target a flight of
+     * length offset to a virtual super-sink. The search stops once no queued vertex can improve the best total.
+     * Every vertex keeps the sources it is closest to, so all tied pairs are found.
+     * A vertex that is both a source and a target is not reported as reached from itself, only from the other
+     * sources that are as close to it (with zero offsets, none: it is not reported at all, as in nearestFlights).\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|E|(log(|V|)+S))</b>, S -> number of sources (merging the closest sources), V -> number of nodes and E is the number of Edges
+     * </pre>
+     * @param context - caller-owned search state, reset by the call (context.getPath(target) gives the route
+     * from one of its closest sources)
+     * @param sources - (source node, offset), e.g. the ground distance to the airport
+     * @param targets - (target node, offset), e.g. the ground distance from the airport
+     * @param airlines - mask of the airlines to use
+     * @param pairs - set to the (source node, target node) pairs with the best total
+     * @return the best offset + distance + offset (SearchContext::INF if no target is reachable)
+     */
+    double nearestDistance(SearchContext &context, const vector<pair<int, double>> &sources,
+                           const vector<pair<int, double>> &targets, const AirlineMask &airlines,
+                           vector<pair<int, int>> &pairs) const;
+
+    /**
+     * Calculates the minimum number of flights from a set of sources to a set of targets with a single bfs seeded
+     * with every source, that stops at the first level holding a target.
+     * Every vertex keeps the sources it is closest to, so all tied pairs are found.
+     * A vertex that is both a source and a target is not reported as reached from itself, and no other source is
+     * closer to it, so it is not reported at all (as in nearestDistance with zero offsets).\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O((|V|+|E|)*S)</b>, S -> number of sources (merging the closest sources), V -> number of nodes, E -> number of edges
+     * </pre>
+     * @param context - caller-owned search state, reset by the call
+     * @param sources - source nodes
+     * @param targets - target nodes
+     * @param airlines - mask of the airlines to use
+     * @param pairs - set to the (source node, target node) pairs joined by the fewest flights
+     * @return the minimum number of flights (INT_MAX if no target is reachable)
+     */
+    int nearestFlights(SearchContext &context, const vector<int> &sources, const vector<int> &targets,
+                       const AirlineMask &airlines, vector<pair<int, int>> &pairs) const;
+
+    /**
+     * Same search as dijkstra, with a FibTree as the priority queue: a vertex is inserted when it is first reached
+     * and its handle is kept for the later decreaseKey calls.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|E| + |V|log(|V|))</b> amortized, V -> number of nodes and E is the number of Edges
+     * </pre>
+     * @param context - caller-owned search state, reset by the call (context.getPath(dest) gives the route)
+     * @param src - source node / node of source airport
+     * @param dest - target node
+     * @param airlines - mask of the airlines to use
+     * @return minimum flown distance between source airport and target airport using airlines (SearchContext::INF if unreachable)
+     */
+    double dijkstraFib(SearchContext &context, int src, int dest, const AirlineMask &airlines) const;
 
     /**
      * Calculates the minimum flown distance between source airport and target airport using airlines \n \n
@@ -291,16 +749,34 @@ public:
      *      <b>O(|E|)</b>,  E is the number of Edges, best case(where the heuristic is ideal for the given problem)
      *      <b>O(|E|log(|V|)</b>, V -> number of nodes and E is the number of Edges, worst case(the heuristic is less informative)
      * </pre>
-     * @note This A* implementation uses the Haversine formula as the heuristic for estimating distances between vertices
-     * @note based on their geographical coordinates.
-     * @note It aims to efficiently find the shortest path in the airway network by considering
-     * @note both the actual distance traveled and the estimated distance to the destination.
+     * @note This A* implementation orders the vertices by g + h, the flown distance plus the straight line (chord)
+     * @note distance to the destination, computed from precomputed unit vectors of the airports.
+     * @note The estimate never exceeds the real distance, so the result is the same as dijkstra's; vertices enter the
+     * @note heap when they are first reached and the search stops as soon as dest is settled.
+     * @note With landmarks, h is the largest of the chord and the ALT triangle inequality bound.
+     * @param context - caller-owned search state, reset by the call (context.getPath(dest) gives the route)
      * @param src - source node / node of source airport
      * @param dest - target node
-     * @param airlines - unordered set of airlines to use (if empty, use all airlines)
-     * @return minimum flown distance between source airport and target airport using airlines
+     * @param airlines - mask of the airlines to use
+     * @param landmarks - optional ALT tables of this graph
+     * @return minimum flown distance between source airport and target airport using airlines (SearchContext::INF if unreachable)
      */
-    Vertex* aStar(int src, int dest, Airline::AirlineH airlines);
+    double aStar(SearchContext &context, int src, int dest, const AirlineMask &airlines,
+                 const Landmarks *landmarks = nullptr) const;
+
+    /**
+     * Calculates the minimum flown distance from src to every vertex (or, with incoming, from every vertex to src),
+     * without a target to stop at.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(|E|log(|V|))</b>, V -> number of nodes and E is the number of Edges
+     * </pre>
+     * @param context - caller-owned search state, reset by the call, holds the distances
+     * @param src - source node (target node with incoming)
+     * @param airlines - mask of the airlines to use
+     * @param incoming - search over the incoming flights
+     */
+    void shortestDistances(SearchContext &context, int src, const AirlineMask &airlines, bool incoming = false) const;
 
     /**
      * Calculates the max distance between connected nodes\n\n
@@ -311,7 +787,7 @@ public:
      * @param v - source node
      * @return the diameter of a connected component
      */
-    int diameterFlights();
+    int diameterFlights() const;
 
 
     /**
@@ -320,10 +796,11 @@ public:
      * <pre>
      *      <b>O(|V|+|E|)</b>, V -> number of nodes, E -> number of edges
      * </pre>
+     * @param context - caller-owned search state, reset by the call
      * @param v - source node
      * @return a vector contain the highest level nodes of the bfs
      */
-    vector<int> bfsHighestLevel(int src, int &level);
+    vector<int> bfsHighestLevel(SearchContext &context, int src, int &level) const;
 
 
     /**
@@ -336,7 +813,7 @@ public:
      * </pre>
      * @return diameter between all connected components.
      */
-    vector<Flight> maxTripSourceDestinationPairs(int diameter);
+    vector<Flight> maxTripSourceDestinationPairs(int diameter) const;
 
 
     /**
@@ -347,10 +824,12 @@ public:
      * </pre>
      * @param v - source node
      * @param index
+     * @param num - discovery index of each node (0 if not discovered yet)
+     * @param low - lowest discovery index reachable from each node
      * @param res - list of articulation points
-     * @param airlines - unordered set of airlines to use (if empty, use all airlines)
+     * @param airlines - mask of the airlines to use
      */
-    void dfsArt(int v, int index, list<int> &res, Airline::AirlineH airlines);
+    void dfsArt(int v, int index, vector<int> &num, vector<int> &low, list<int> &res, const AirlineMask &airlines) const;
 
     /**
      * Calculates the list of articulation points that exist in a specific unordered_set of airlines or in all airlines.\n\n
@@ -358,10 +837,10 @@ public:
      * <pre>
      *      <b>O((|V| + |E|) * n)</b>, V -> number of nodes, E -> number of edges, n-> list size
      * </pre>
-     * @param airlines - unordered set of airlines to use (if empty, use all airlines)
+     * @param airlines - mask of the airlines to use
      * @return The list of articulation points.
      */
-    list<int> articulationPoints(const Airline::AirlineH& airlines);
+    list<int> articulationPoints(const AirlineMask& airlines) const;
 
     /**
      * Searches all the airlines that can be used to travel between a source and dest with a certain user input of airlines(or none).\n\n
@@ -371,10 +850,10 @@ public:
      * </pre>
      * @param src - source node
      * @param dest - final node
-     * @param airlines - unordered_set of airlines that without user input is empty, if has user input only uses those specific airlines.
-     * @return vector of the possible airlines to use to travel from src to dest
+     * @param airlines - mask of the airlines to use, that without user input accepts every airline.
+     * @return vector of the ids of the possible airlines to use to travel from src to dest
      */
-    vector<string> getAirlines(int src, int dest, Airline::AirlineH airlines);
+    vector<Airline::Id> getAirlines(int src, int dest, const AirlineMask &airlines) const;
 
     /**
      * Prints a possible path from a source airport to a target airport\n\n
@@ -383,35 +862,70 @@ public:
      *      <b>O(n * m)</b>, n -> path size , m -> possibleAirlines size
      * </pre>
      * @param path - visited nodes during the path
-     * @param airlines - unordered set of airlines to use (if empty, use all airlines)
+     * @param airlines - mask of the airlines to use
      */
-    void printPath(vector<int>,const Airline::AirlineH&);
+    void printPath(vector<int>,const AirlineMask&) const;
 
     /**
-     * Calculates (using bfs) and prints most optimal path of flights(least amount of flights)\n\n
+     * Calculates (using bfs) and prints the most optimal paths of flights (least amount of flights), enumerated
+     * lazily from their ShortestPathDag until limit paths were printed\n\n
      * <b>Complexity\n</b>
      * <pre>
-     *      <b>O((|V|+|E|) * p)</b>, V -> number of nodes , E-> number of edges, p-> possibleAirlines size
+     *      <b>O(|V|+|E| + k*L*p)</b>, V -> number of nodes , E-> number of edges, k -> paths printed, L -> flights per path, p-> possibleAirlines size
      * </pre>
-     * @param nrPath
+     * @param context - caller-owned search state, reset by the call
+     * @param nrPath - number of paths printed so far, updated
+     * @param start - source node
+     * @param end - final node
+     * @param airlines - mask of the airlines to use
+     * @param limit - stop printing once nrPath reaches it
+     * @return the number of paths from start to end (ShortestPathDag::MANY if it does not fit), printed or not
+     */
+    uint64_t printPathsByFlights(SearchContext &context, int& nrPath, int start, int end, const AirlineMask& airlines,
+                                 int limit = INT_MAX) const;
+
+    /**
+     * Prints a route flown with the given airlines\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(n)</b>, n -> path size
+     * </pre>
+     * @param path - airports of the route (nothing is printed if it is empty)
+     * @param legs - airline of each flight (legs[i] flies path[i] -> path[i+1])
+     */
+    void printRoute(const vector<int> &path, const vector<Airline::Id> &legs) const;
+
+    /**
+     * Prints the routes from start to end that come after the shortest one by flown distance (see kShortestPaths),
+     * with their distances\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(k*L*|E|log(|V|))</b>, L -> number of airports of a route, V -> number of nodes and E is the number of Edges
+     * </pre>
+     * @param context - caller-owned search state, reset by the call
      * @param start - source node
      * @param end - final node
-     * @param airlines - unordered set of airlines to use (if empty, use all airlines)
+     * @param k - number of alternatives to print
+     * @param airlines - mask of the airlines to use
      */
-    void printPathsByFlights(int& nrPath, int start, int end, const Airline::AirlineH& airlines);
+    void printAlternativePaths(SearchContext &context, int start, int end, int k, const AirlineMask& airlines) const;
 
     /**
-     * Calculates and prints the most optimal paths based on distance of nodes using the dijkstra algorithm.\n\n
+     * Calculates and prints the most optimal paths based on distance of nodes (see distance: the contraction
+     * hierarchy when there is one and no airline is filtered out, bidirectionalDijkstra otherwise).\n\n
      * <b>Complexity\n</b>
      * <pre>
      *      <b>O(log(|V|) * p)</b>, V -> number of nodes , p -> possibleAirlines size
      * </pre>
+     * @param context - caller-owned search state, reset by the call
+     * @param backward - caller-owned backward search state, reset by the call
      * @param nrPath
      * @param start - source node
      * @param end  - final node
-     * @param airlines - unordered set of airlines to use (if empty, use all airlines)
+     * @param airlines - mask of the airlines to use
      */
-    void printPathsByDistance(int& nrPath, int start, int end, const Airline::AirlineH& airlines);
+    void printPathsByDistance(SearchContext &context, SearchContext &backward, int& nrPath, int start, int end,
+                              const AirlineMask& airlines) const;
 
 };
 
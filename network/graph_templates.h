@@ -8,30 +8,30 @@
  * @brief Contains Graph template functions implementations
  */
 template<typename Container>
-Container Graph::listReachableEntities(int v, int max) {
-    for (int i = 0; i < getNumVertex(); i++)
-        vertexSet[i]->setVisited(false);
+Container Graph::listReachableEntities(SearchContext &context, int v, int max) const {
+    context.reset(getNumVertex());
 
     Container entities;
 
     queue<int> q;
     q.push(v);
-    vertexSet[v]->setVisited(true);
-    vertexSet[v]->distance = 0;
+    context.setVisited(v);
+    context.setDistance(v, 0, -1);
 
+    const CSR &g = *csr;
     while (!q.empty()) {
         int u = q.front(); q.pop();
-        for (const auto& e : vertexSet[u]->getAdj()) {
+        for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
 
-            int w = e.dest->getId();
+            int w = g.dest[e];
 
-            if (!vertexSet[w]->isVisited()) {
+            if (!context.isVisited(w)) {
 
                 q.push(w);
-                vertexSet[w]->setVisited(true);
-                vertexSet[w]->distance = vertexSet[u]->getDistance() + 1;
+                context.setVisited(w);
+                context.setDistance(w, context.getDistance(u) + 1, u);
 
-                if (vertexSet[w]->getDistance() <= max) {
+                if (context.getDistance(w) <= max) {
 
                     if constexpr (std::is_same<Container, Airport::AirportH>::value) {
                         entities.insert(vertexSet[w]->getAirport());
@@ -49,4 +49,46 @@ Container Graph::listReachableEntities(int v, int max) {
     return entities;
 }
 
+template <class Queue, class Skip>
+double Graph::dijkstra(SearchContext &context, Queue &queue, int src, int dest, const AirlineMask &airlines,
+                       bool hops, Skip skip) const {
+
+    if(!findVertex(src) || !findVertex(dest))
+        return SearchContext::INF;
+
+    context.reset(getNumVertex());
+    queue.reset(getNumVertex());
+
+    context.setDistance(src, 0, -1);
+    queue.insert(src, 0);
+
+    const CSR &g = *csr;
+    while(!queue.empty()){
+
+        auto u = queue.extractMin();
+        context.setVisited(u);
+        if (u == dest) break; // settled, its distance is final
+
+        for(int e = g.offsets[u]; e < g.offsets[u + 1]; e++){
+
+            if (!airlines.allows(g.airline[e])) continue;
+
+            auto v = g.dest[e];
+            double w = hops ? 1 : g.weight[e];
+            if (skip(u, v)) continue;
+
+            if(!context.isVisited(v) && context.getDistance(u) + w < context.getDistance(v)){
+
+                bool queued = context.getDistance(v) != SearchContext::INF;
+                context.setDistance(v, context.getDistance(u) + w, u);
+                if (queued) queue.decreaseKey(v, context.getDistance(v));
+                else queue.insert(v, context.getDistance(v));
+
+            }
+        }
+    }
+
+    return context.getDistance(dest);
+}
+
 #endif //AIRBUSMANAGEMENTSYSTEM_GRAPH_TEMPLATES_H
@@ -0,0 +1,143 @@
+#include "landmarks.h"
+#include "graph.h"
+#include "../classes/MappedFile.h"
+#include "../classes/Snapshot.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+/**
+ * @file
+ * @brief Contains the Landmarks class implementation
+ */
+static const char MAGIC[8] = {'A', 'B', 'M', 'L', 'M', 'K', 'S', '\0'};
+
+/**
+ * First bytes of a landmarks file, followed by int landmarks[k], double from[k * n] and double to[k * n].
+ * requested is the k the tables were computed for, larger than k when farthest selection ran out of airports.
+ */
+struct LandmarksHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t k;
+    uint64_t sourceChecksum;
+    uint64_t payloadChecksum;
+    uint32_t nrVertices;
+    uint32_t requested;
+};
+
+Landmarks::Landmarks(const Graph &graph, int k) {
+    nrVertices = graph.getNumVertex();
+    requested = k;
+    if (nrVertices == 0 || k <= 0) return;
+
+    SearchContext context(nrVertices);
+    AirlineMask all;
+
+    int start = 0; // the busiest hub
+    for (int v = 0; v < nrVertices; v++)
+        if (graph.getOutDegree(v) > graph.getOutDegree(start)) start = v;
+
+    // the farthest airport that the hub reaches
+    graph.shortestDistances(context, start, all);
+    int next = start;
+    for (int v = 0; v < nrVertices; v++)
+        if (context.getDistance(v) != SearchContext::INF && context.getDistance(v) > context.getDistance(next))
+            next = v;
+
+    vector<double> closest(nrVertices, SearchContext::INF); // distance to the nearest landmark chosen so far
+    while ((int)landmarks.size() < k) {
+        landmarks.push_back(next);
+
+        graph.shortestDistances(context, next, all);
+        for (int v = 0; v < nrVertices; v++) {
+            from.push_back(context.getDistance(v));
+            closest[v] = min(closest[v], context.getDistance(v));
+        }
+        graph.shortestDistances(context, next, all, true);
+        for (int v = 0; v < nrVertices; v++)
+            to.push_back(context.getDistance(v));
+
+        // the airport farthest from every landmark, among the ones the first landmark reaches
+        next = -1;
+        for (int v = 0; v < nrVertices; v++) {
+            if (from[v] == SearchContext::INF || closest[v] == SearchContext::INF) continue;
+            if (next == -1 || closest[v] > closest[next]) next = v;
+        }
+        if (next == -1 || closest[next] == 0) break; // every reachable airport is already a landmark
+    }
+}
+
+double Landmarks::lowerBound(int v, int t) const {
+    double bound = 0;
+    for (int i = 0; i < (int)landmarks.size(); i++) {
+        const double *f = &from[(size_t)i * nrVertices], *b = &to[(size_t)i * nrVertices];
+        if (f[t] != SearchContext::INF && f[v] != SearchContext::INF)
+            bound = max(bound, f[t] - f[v]);
+        if (b[v] != SearchContext::INF && b[t] != SearchContext::INF)
+            bound = max(bound, b[v] - b[t]);
+    }
+    return bound;
+}
+
+bool Landmarks::save(const string &path, uint64_t sourceChecksum) const {
+    LandmarksHeader header{};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.k = landmarks.size();
+    header.sourceChecksum = sourceChecksum;
+    header.nrVertices = nrVertices;
+    header.requested = requested;
+
+    uint64_t hash = Snapshot::FNV_OFFSET;
+    hash = Snapshot::fnv1a((const char *)landmarks.data(), landmarks.size() * sizeof(int), hash);
+    hash = Snapshot::fnv1a((const char *)from.data(), from.size() * sizeof(double), hash);
+    hash = Snapshot::fnv1a((const char *)to.data(), to.size() * sizeof(double), hash);
+    header.payloadChecksum = hash;
+
+    string tmp = path + ".tmp";
+    {
+        ofstream out(tmp, ios::binary | ios::trunc);
+        out.write((const char *)&header, sizeof(header));
+        out.write((const char *)landmarks.data(), (streamsize)(landmarks.size() * sizeof(int)));
+        out.write((const char *)from.data(), (streamsize)(from.size() * sizeof(double)));
+        out.write((const char *)to.data(), (streamsize)(to.size() * sizeof(double)));
+        if (!out) return false;
+    }
+    return rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+bool Landmarks::load(const string &path, uint64_t sourceChecksum, int nrVertices, int k) {
+    MappedFile file(path);
+    if (!file.isOpen() || file.size() < sizeof(LandmarksHeader)) return false;
+
+    LandmarksHeader header{};
+    memcpy(&header, file.data(), sizeof(header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) return false;
+    if (header.sourceChecksum != sourceChecksum || (int)header.nrVertices != nrVertices ||
+        (int)header.requested != k || (int)header.k > k)
+        return false;
+
+    size_t tableSize = (size_t)header.k * header.nrVertices;
+    size_t expected = sizeof(header) + header.k * sizeof(int) + 2 * tableSize * sizeof(double);
+    if (file.size() != expected) return false;
+    if (Snapshot::fnv1a(file.data() + sizeof(header), file.size() - sizeof(header), Snapshot::FNV_OFFSET)
+        != header.payloadChecksum) return false;
+
+    const char *p = file.data() + sizeof(header);
+    vector<int> l(header.k);
+    memcpy(l.data(), p, header.k * sizeof(int));
+    p += header.k * sizeof(int);
+    for (int v : l)
+        if (v < 0 || v >= nrVertices) return false;
+
+    landmarks = std::move(l);
+    this->nrVertices = nrVertices;
+    requested = k;
+    from.resize(tableSize);
+    to.resize(tableSize);
+    memcpy(from.data(), p, tableSize * sizeof(double));
+    memcpy(to.data(), p + tableSize * sizeof(double), tableSize * sizeof(double));
+    return true;
+}
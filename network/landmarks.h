@@ -0,0 +1,94 @@
+#ifndef AIRBUSMANAGEMENTSYSTEM_LANDMARKS_H
+#define AIRBUSMANAGEMENTSYSTEM_LANDMARKS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class Graph;
+
+/**
+ * @file
+ * @brief Contains the Landmarks class, the preprocessing of the ALT (A*, Landmarks, Triangle inequality) heuristic.
+ */
+
+/**
+ * @class Landmarks
+ * @brief Flown distances from and to a few landmark airports, used as an A* lower bound.
+ *
+ * For a landmark L the triangle inequality gives d(v,t) >= d(L,t) - d(L,v) and d(v,t) >= d(v,L) - d(t,L).
+ * The best of these bounds over the landmarks is much tighter than the straight line distance in a hub and spoke
+ * network, where routes go far out of the way. The tables are computed without airline filter and filtering only
+ * removes flights, so the bounds also hold for filtered searches.
+ */
+class Landmarks {
+public:
+    static constexpr uint32_t VERSION = 2; ///< Bumped whenever the file layout changes.
+
+    /**
+     * @brief Constructor for an empty set of landmarks (no bound).
+     */
+    Landmarks() = default;
+
+    /**
+     * @brief Picks k landmarks by farthest selection and computes their distance tables.
+     * The first landmark is the airport farthest from the busiest hub, every next one the airport farthest
+     * from the landmarks already chosen.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(k*|E|log(|V|))</b>, two one-to-all searches per landmark
+     * </pre>
+     * @param graph Frozen graph.
+     * @param k Number of landmarks.
+     */
+    Landmarks(const Graph &graph, int k);
+
+    /**
+     * @brief Checks if there are no landmarks.
+     */
+    [[nodiscard]] bool empty() const {return landmarks.empty();}
+
+    /**
+     * @brief Gets the vertex id of every landmark.
+     */
+    [[nodiscard]] const vector<int> &getLandmarks() const {return landmarks;}
+
+    /**
+     * @brief Lower bound of the flown distance from v to t.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(k)</b>, k -> number of landmarks
+     * </pre>
+     */
+    [[nodiscard]] double lowerBound(int v, int t) const;
+
+    /**
+     * @brief Writes the landmarks and their tables to a file.
+     * @param path Path of the file.
+     * @param sourceChecksum Checksum of the data files the graph was loaded from (see Snapshot::checksum).
+     * @return true if the file was written.
+     */
+    bool save(const string &path, uint64_t sourceChecksum) const;
+
+    /**
+     * @brief Reads landmarks written by save.
+     * @param path Path of the file.
+     * @param sourceChecksum Checksum of the current data files.
+     * @param nrVertices Number of vertices of the current graph.
+     * @param k Wanted number of landmarks, as passed to the constructor (the file holds fewer when every reachable
+     * airport became a landmark first).
+     * @return true if the file matched and was loaded, false if the landmarks must be computed again.
+     */
+    bool load(const string &path, uint64_t sourceChecksum, int nrVertices, int k);
+
+private:
+    vector<int> landmarks;
+    int nrVertices = 0;
+    int requested = 0;   // k asked for: more than landmarks.size() when farthest selection ran out of airports
+    vector<double> from; // from[i * nrVertices + v] = distance from landmark i to v (INF if unreachable)
+    vector<double> to;   // to[i * nrVertices + v] = distance from v to landmark i (INF if unreachable)
+};
+
+#endif //AIRBUSMANAGEMENTSYSTEM_LANDMARKS_H
@@ -0,0 +1,39 @@
+#include "search_context.h"
+
+#include <algorithm>
+
+/**
+ * @file
+ * @brief Contains the SearchContext class implementation
+ */
+SearchContext::SearchContext(int n) {
+    reset(n);
+}
+
+void SearchContext::reset(int n) {
+    if ((int)touched.size() < n) {
+        distance.resize(n);
+        parent.resize(n);
+        parents.resize(n);
+        touched.resize(n, 0);
+        visitedAt.resize(n, 0);
+    }
+
+    if (++generation == 0) { // the counter wrapped around, old stamps could match again
+        fill(touched.begin(), touched.end(), 0);
+        fill(visitedAt.begin(), visitedAt.end(), 0);
+        generation = 1;
+    }
+    heap.reset(n);
+}
+
+vector<int> SearchContext::getPath(int dest) const {
+    vector<int> path;
+    if (getDistance(dest) == INF)
+        return path;
+
+    for (int v = dest; v != -1; v = getParent(v))
+        path.push_back(v);
+    reverse(path.begin(), path.end());
+    return path;
+}
@@ -0,0 +1,125 @@
+#ifndef AIRBUSMANAGEMENTSYSTEM_SEARCH_CONTEXT_H
+#define AIRBUSMANAGEMENTSYSTEM_SEARCH_CONTEXT_H
+
+#include <vector>
+#include <climits>
+#include "../classes/SearchQueue.h"
+
+using namespace std;
+
+/**
+ * @file
+ * @brief Contains the SearchContext class, the per-query state of the Graph algorithms.
+ */
+
+/**
+ * @class SearchContext
+ * @brief Distance, parent and visited arrays of one graph search, owned by the caller.
+ *
+ * Keeping this state out of the vertices makes the Graph immutable, so several searches may run at the same time
+ * as long as each one uses its own context.\n
+ * Every entry is stamped with the generation in which it was written and reset() only starts a new generation,
+ * so an entry from a previous search is seen as untouched: there is no O(|V|) reset loop at the start of a query.
+ * The context also owns the priority queue of the search, so reusing a context reuses its heap arrays too;
+ * its discipline (SearchQueue::Mode) is chosen by the caller and kept across resets.
+ */
+class SearchContext {
+public:
+    static constexpr double INF = INT_MAX; ///< Distance of a vertex that was not reached.
+
+    /**
+     * @brief Constructor for a context able to search a graph with n vertices.
+     * @param n Number of vertices.
+     */
+    explicit SearchContext(int n = 0);
+
+    /**
+     * @brief Prepares the context for a new search, forgetting every distance, parent and visited mark
+     * and emptying the heap.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(1)</b> plus the keys left in the heap (O(n) only when the context grows or the generation counter wraps around)
+     * </pre>
+     * @param n Number of vertices of the graph to search.
+     */
+    void reset(int n);
+
+    /**
+     * @brief Gets the distance of a vertex in the current search.
+     * @return The distance, or INF if the vertex was not reached.
+     */
+    [[nodiscard]] double getDistance(int v) const {return touched[v] == generation ? distance[v] : INF;}
+
+    /**
+     * @brief Gets the vertex from where v was reached in the current search.
+     * @return The parent, or -1 if v is the source or was not reached.
+     */
+    [[nodiscard]] int getParent(int v) const {return touched[v] == generation ? parent[v] : -1;}
+
+    /**
+     * @brief Gets every parent of v that lies on a shortest path (filled by Graph::bfsPath).
+     */
+    [[nodiscard]] const vector<int> &getParents(int v) const {return touched[v] == generation ? parents[v] : noParents;}
+
+    /**
+     * @brief Sets the distance of v and the vertex from where it was reached.
+     */
+    void setDistance(int v, double d, int p) {touch(v); distance[v] = d; parent[v] = p;}
+
+    /**
+     * @brief Appends a shortest path parent to v.
+     */
+    void addParent(int v, int p) {touch(v); parents[v].push_back(p);}
+
+    /**
+     * @brief Removes every shortest path parent of v.
+     */
+    void clearParents(int v) {touch(v); parents[v].clear();}
+
+    /**
+     * @brief Gets the priority queue of the search, empty after reset.
+     */
+    SearchQueue &getHeap() {return heap;}
+
+    /**
+     * @brief Selects how the searches run with this context handle improved keys (see SearchQueue).
+     */
+    void setQueueMode(SearchQueue::Mode mode) {heap.setMode(mode);}
+
+    [[nodiscard]] bool isVisited(int v) const {return visitedAt[v] == generation;}
+    void setVisited(int v) {visitedAt[v] = generation;}
+
+    /**
+     * @brief Rebuilds the path that reached dest by following the parents.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(n)</b>, n -> path size
+     * </pre>
+     * @param dest - final node
+     * @return the nodes from the source to dest, or an empty vector if dest was not reached
+     */
+    [[nodiscard]] vector<int> getPath(int dest) const;
+
+private:
+    vector<double> distance;
+    vector<int> parent;
+    vector<vector<int>> parents;
+    vector<unsigned> touched;   // generation in which distance, parent and parents of the vertex were written
+    vector<unsigned> visitedAt; // generation in which the vertex was marked as visited
+    unsigned generation = 0;
+    SearchQueue heap;
+    const vector<int> noParents;
+
+    /*!
+     * @note Auxiliary function that clears the entry of v if it was written by a previous search.
+     */
+    void touch(int v) {
+        if (touched[v] == generation) return;
+        touched[v] = generation;
+        distance[v] = INF;
+        parent[v] = -1;
+        parents[v].clear();
+    }
+};
+
+#endif //AIRBUSMANAGEMENTSYSTEM_SEARCH_CONTEXT_H
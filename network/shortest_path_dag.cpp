@@ -0,0 +1,65 @@
+#include "shortest_path_dag.h"
+#include <algorithm>
+
+ShortestPathDag::ShortestPathDag(const SearchContext &context, int dest, int n) {
+    if (dest < 0 || dest >= n || context.getDistance(dest) == SearchContext::INF) return;
+    flights = (int)context.getDistance(dest);
+
+    // breadth-first walk up the parents: every parent is one flight closer to the source, so it is numbered after
+    // all the vertices it is a parent of
+    vector<int> local(n, -1);
+    local[dest] = 0;
+    vertices.push_back(dest);
+    offsets.push_back(0);
+    for (size_t i = 0; i < vertices.size(); i++) {
+        for (int p : context.getParents(vertices[i])) {
+            if (p == -1) continue; // the source
+            if (local[p] == -1) {
+                local[p] = (int)vertices.size();
+                vertices.push_back(p);
+            }
+            preds.push_back(local[p]);
+        }
+        offsets.push_back((int)preds.size());
+    }
+
+    counts.assign(vertices.size(), 0);
+    for (int i = (int)vertices.size() - 1; i >= 0; i--) {
+        if (offsets[i] == offsets[i + 1]) {
+            counts[i] = 1; // the source
+            continue;
+        }
+        for (int k = offsets[i]; k < offsets[i + 1]; k++) {
+            uint64_t c = counts[preds[k]];
+            counts[i] = c > MANY - counts[i] ? MANY : counts[i] + c;
+        }
+    }
+}
+
+ShortestPathDag::Iterator::Iterator(const ShortestPathDag &dag, uint64_t limit)
+        : dag(&dag), remaining(limit), choice(max(dag.flights, 0), 0), trail(max(dag.flights, 0) + 1),
+          done(!dag.isReachable() || limit == 0) {}
+
+bool ShortestPathDag::Iterator::next(vector<int> &path) {
+    if (done) return false;
+
+    int flights = dag->flights;
+    trail[0] = 0;
+    for (int i = 0; i < flights; i++)
+        trail[i + 1] = dag->preds[dag->offsets[trail[i]] + choice[i]];
+
+    path.resize(flights + 1);
+    for (int i = 0; i <= flights; i++)
+        path[flights - i] = dag->vertices[trail[i]];
+
+    // next choice: the deepest vertex that still has another parent takes it, the ones below start over
+    int i = flights - 1;
+    while (i >= 0 && choice[i] + 1 == dag->offsets[trail[i] + 1] - dag->offsets[trail[i]]) i--;
+    if (i < 0) done = true;
+    else {
+        choice[i]++;
+        fill(choice.begin() + i + 1, choice.end(), 0);
+    }
+    if (--remaining == 0) done = true;
+    return true;
+}
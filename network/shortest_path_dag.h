@@ -0,0 +1,100 @@
+#ifndef AIRBUSMANAGEMENTSYSTEM_SHORTEST_PATH_DAG_H
+#define AIRBUSMANAGEMENTSYSTEM_SHORTEST_PATH_DAG_H
+
+#include <cstdint>
+#include <vector>
+#include "search_context.h"
+
+using namespace std;
+
+/**
+ * @file
+ * @brief Contains the ShortestPathDag class, every route with the fewest flights between two airports.
+ */
+
+/**
+ * @class ShortestPathDag
+ * @brief The airports and flights that lie on some route with the fewest flights from a source to a target.
+ *
+ * Built from the parents left by Graph::bfsPath, keeping only the ancestors of the target: their parents are stored
+ * as one flat array (preds[offsets[i]..offsets[i+1]) are the parents of the i-th vertex), so the DAG takes
+ * O(vertices + flights on the routes) memory however many routes there are.\n
+ * The number of routes reaching each vertex is the sum over its parents and is computed in one pass, from the source
+ * up; the routes themselves are only enumerated on demand, one at a time, by an Iterator.
+ */
+class ShortestPathDag {
+public:
+    static constexpr uint64_t MANY = UINT64_MAX; ///< Number of routes when it does not fit in 64 bits.
+
+    /**
+     * @brief Lazy enumeration of the routes of a ShortestPathDag, in the order Graph::bfsPath found the parents.
+     *
+     * The route is a choice of parent at every vertex from the target down; next advances the choice closest to
+     * the source first, like an odometer, so every call costs O(flights of the route).
+     */
+    class Iterator {
+    public:
+        /**
+         * @brief Writes the next route into path (from the source to the target).\n\n
+         * <b>Complexity\n</b>
+         * <pre>
+         *      <b>O(L)</b>, L -> number of flights of the route
+         * </pre>
+         * @return false, leaving path untouched, when every route (or limit routes) was given.
+         */
+        bool next(vector<int> &path);
+
+    private:
+        friend class ShortestPathDag;
+
+        const ShortestPathDag *dag;
+        uint64_t remaining;
+        vector<int> choice; // choice[i] = index, among its parents, of the parent taken at the i-th vertex from the target
+        vector<int> trail;  // trail[i] = the i-th vertex from the target of the current route
+        bool done;
+
+        Iterator(const ShortestPathDag &dag, uint64_t limit);
+    };
+
+    /**
+     * @brief Constructor for the DAG of the routes from the source of a Graph::bfsPath search to dest.\n\n
+     * <b>Complexity\n</b>
+     * <pre>
+     *      <b>O(n + A + P)</b>, n -> vertices of the graph, A -> ancestors of dest, P -> their parents
+     * </pre>
+     * @param context - search state filled by Graph::bfsPath
+     * @param dest - target node
+     * @param n - number of vertices of the graph
+     */
+    ShortestPathDag(const SearchContext &context, int dest, int n);
+
+    /**
+     * @brief Checks if the target was reached.
+     */
+    [[nodiscard]] bool isReachable() const {return !vertices.empty();}
+
+    /**
+     * @brief Gets the number of flights of every route (-1 if the target was not reached).
+     */
+    [[nodiscard]] int getFlights() const {return flights;}
+
+    /**
+     * @brief Gets the number of routes with the fewest flights, MANY if there are more than 64 bits can count.
+     */
+    [[nodiscard]] uint64_t getNrPaths() const {return isReachable() ? counts[0] : 0;}
+
+    /**
+     * @brief Starts an enumeration of the routes.
+     * @param limit - maximum number of routes to give
+     */
+    [[nodiscard]] Iterator paths(uint64_t limit = MANY) const {return Iterator(*this, limit);}
+
+private:
+    vector<int> vertices; // graph vertex of each DAG vertex, the target first, by non-increasing distance
+    vector<int> offsets;  // parents of the i-th vertex are preds[offsets[i]..offsets[i+1])
+    vector<int> preds;    // indices in vertices
+    vector<uint64_t> counts; // routes from the source to each vertex
+    int flights = -1;
+};
+
+#endif //AIRBUSMANAGEMENTSYSTEM_SHORTEST_PATH_DAG_H
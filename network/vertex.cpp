@@ -20,16 +20,8 @@ Airport Vertex::getAirport() {
     return airport;
 }
 
-bool Vertex::isProcessing() const {
-    return processing;
-}
-
-void Vertex::setProcessing(bool p) {
-    Vertex::processing = p;
-}
-
 
-void Vertex::addEdge(Vertex *d, const Airline& airline, double w) {
+void Vertex::addEdge(Vertex *d, Airline::Id airline, double w) {
     adj.emplace_back(d, airline, w);
 }
 